@@ -0,0 +1,166 @@
+#include "Benchmark.h"
+#include "Solver.h"
+#include "Timer.h"
+#include "WordleDictionary.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace
+{
+   constexpr int MAX_FIRST_GUESSES_FOR_OPTIMAL_GUESS = 200; // the buckets of this many first guesses are the inputs to `optimalGuess`
+
+   const char* REPORT_HEADER = "name,size,repetitions,min_seconds,median_seconds,items,ns_per_item";
+}
+
+void Benchmark::run( const vector<int>& sizes, ostream& log )
+{
+   for ( int size : sizes )
+   {
+      benchmarkCalcBucketForGuess( size, log );
+      benchmarkTableConstruction( size, log );
+      benchmarkOptimalGuess( size, log );
+      benchmarkCalcScore( size, log );
+   }
+}
+
+void Benchmark::time( const string& name, int size, double items, const function<long long()>& fn, ostream& log, const function<void()>& setup )
+{
+   vector<double> seconds;
+   long long checksum = 0;
+   for ( int i = 0; i < _repetitions; i++ )
+   {
+      if ( setup )
+         setup();
+      Timer t;
+      checksum += fn();
+      seconds.push_back( t.elapsedTime() );
+   }
+   sort( seconds.begin(), seconds.end() );
+
+   Result result = { name, size, _repetitions, seconds[0], seconds[seconds.size() / 2], items };
+   _results.push_back( result );
+   log << name << " " << size << ": min = " << result.minSeconds << "s, median = " << result.medianSeconds << "s, "
+       << result.nsPerItem() << " ns/item (checksum " << checksum << ")" << endl;
+}
+
+// every (guess, answer) pair of the first `size` words
+void Benchmark::benchmarkCalcBucketForGuess( int size, ostream& log )
+{
+   vector<string> words = WordleDictionary::getWords( size );
+   time( "calcBucketForGuess", size, (double) size * size, [&]()
+   {
+      long long sum = 0;
+      for ( const string& guess : words )
+         for ( const string& answer : words )
+            sum += calcBucketForGuess( guess, answer );
+      return sum;
+   }, log );
+}
+
+// the fast builder (on `g_numThreads` threads) and the reference one (one `calcBucketForGuess` per pair), which have to agree
+void Benchmark::benchmarkTableConstruction( int size, ostream& log )
+{
+   vector<string> words = WordleDictionary::getWords( size );
+   BucketForGuessTable reference( words, BucketForGuessTable::Builder::Reference );
+   if ( !( BucketForGuessTable( words, BucketForGuessTable::Builder::Fast ) == reference ) )
+      throw "in `Benchmark::benchmarkTableConstruction`: fast and reference tables differ";
+
+   time( "tableFast", size, (double) size * size, [&]() { return (long long) BucketForGuessTable( words, BucketForGuessTable::Builder::Fast ).bucket( size-1, size-1 ); }, log );
+   time( "tableReference", size, (double) size * size, [&]() { return (long long) BucketForGuessTable( words, BucketForGuessTable::Builder::Reference ).bucket( size-1, size-1 ); }, log );
+}
+
+// the subproblems that are left after the first guess, for each of the first few guesses
+void Benchmark::benchmarkOptimalGuess( int size, ostream& log )
+{
+   setDictionary( size );
+   vector<int> answers = allAnswers();
+   vector<vector<int>> subproblems;
+   for ( int guess = 0; guess < min( size, MAX_FIRST_GUESSES_FOR_OPTIMAL_GUESS ); guess++ )
+   {
+      vector<vector<int>> wordsForBucket( NUM_BUCKETS );
+      for ( int answer : answers )
+         wordsForBucket[g_BucketForGuessTable.bucket( guess, answer )].push_back( answer );
+      for ( vector<int>& words : wordsForBucket )
+         if ( !words.empty() )
+            subproblems.push_back( move( words ) );
+   }
+
+   time( "optimalGuess", size, (double) subproblems.size(), [&]()
+   {
+      long long sum = 0;
+      for ( const vector<int>& words : subproblems )
+         sum += optimalGuess( words, g_numGuesses-1 );
+      return sum;
+   }, log );
+}
+
+// solving the whole dictionary from a cold transposition cache
+void Benchmark::benchmarkCalcScore( int size, ostream& log )
+{
+   setDictionary( size );
+   vector<int> words = rootWords();
+   double score = 0;
+   time( "calcScore", size, 1, [&]()
+   {
+      int bestGuess = words[0];
+      score = calcScore( words, bestGuess, g_numGuesses );
+      return (long long) bestGuess;
+   }, log, []()
+   {
+      // (clearing the whole table costs more than solving the small sizes, so it isn't timed)
+      g_transpositionCache.allocate();
+      g_transpositionCache.clear();
+   } );
+   log << "   score = " << score << endl;
+}
+
+void Benchmark::writeReport( ostream& out ) const
+{
+   out << REPORT_HEADER << "\n";
+   for ( const Result& result : _results )
+      out << result.name << "," << result.size << "," << result.repetitions << "," << result.minSeconds << "," << result.medianSeconds << ","
+          << (long long) result.items << "," << result.nsPerItem() << "\n";
+}
+
+vector<Benchmark::Result> Benchmark::readReport( istream& in )
+{
+   string line;
+   if ( !getline( in, line ) || line != REPORT_HEADER )
+      throw "in `Benchmark::readReport`: not a benchmark report";
+
+   vector<Result> results;
+   while ( getline( in, line ) )
+   {
+      if ( line.empty() )
+         continue;
+      replace( line.begin(), line.end(), ',', ' ' );
+      istringstream fields( line );
+      Result result;
+      if ( !( fields >> result.name >> result.size >> result.repetitions >> result.minSeconds >> result.medianSeconds >> result.items ) )
+         throw "in `Benchmark::readReport`: malformed line";
+      results.push_back( result );
+   }
+   return results;
+}
+
+int Benchmark::compare( const vector<Result>& baseline, double tolerance, ostream& out ) const
+{
+   int numRegressions = 0;
+   for ( const Result& result : _results )
+   {
+      auto it = find_if( baseline.begin(), baseline.end(), [&]( const Result& r ) { return r.name == result.name && r.size == result.size; } );
+      if ( it == baseline.end() )
+         continue;
+      double ratio = result.minSeconds / it->minSeconds;
+      if ( ratio > 1 + tolerance )
+      {
+         out << "regression: " << result.name << " " << result.size << ": " << result.minSeconds << "s vs " << it->minSeconds << "s (" << ratio << "x)" << endl;
+         numRegressions++;
+      }
+   }
+   return numRegressions;
+}
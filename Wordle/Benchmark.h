@@ -0,0 +1,50 @@
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// times the main pieces of the solver at several dictionary sizes, and compares the timings against an earlier report
+// (the report is CSV with one line per benchmark and size, so reports from different builds can be diffed or plotted)
+class Benchmark
+{
+public:
+   struct Result
+   {
+      std::string name;
+      int size;
+      int repetitions;
+      double minSeconds;
+      double medianSeconds;
+      double items; // the work done per repetition (calls, word pairs, ...)
+
+      double nsPerItem() const { return minSeconds / items * 1e9; }
+   };
+
+   explicit Benchmark( int repetitions ) : _repetitions( repetitions ) {}
+
+   // runs every benchmark for each dictionary size, printing each result to `log` as it finishes
+   void run( const std::vector<int>& sizes, std::ostream& log );
+
+   const std::vector<Result>& results() const { return _results; }
+
+   void writeReport( std::ostream& out ) const;
+   static std::vector<Result> readReport( std::istream& in );
+
+   // prints each result that is more than `tolerance` (e.g. 0.1 = 10%) slower than the same benchmark in `baseline`, and returns how many were
+   // (min times are compared, since they are the least noisy)
+   int compare( const std::vector<Result>& baseline, double tolerance, std::ostream& out ) const;
+
+private:
+   // times `fn` `_repetitions` times (`fn` returns a checksum, so the work can't be optimized away), calling `setup` untimed before each
+   void time( const std::string& name, int size, double items, const std::function<long long()>& fn, std::ostream& log, const std::function<void()>& setup = {} );
+
+   void benchmarkCalcBucketForGuess( int size, std::ostream& log );
+   void benchmarkTableConstruction( int size, std::ostream& log );
+   void benchmarkOptimalGuess( int size, std::ostream& log );
+   void benchmarkCalcScore( int size, std::ostream& log );
+
+   int _repetitions;
+   std::vector<Result> _results;
+};
@@ -0,0 +1,276 @@
+#include "BucketForGuessTable.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if defined( _M_X64 ) || defined( __x86_64__ )
+#define WORDLE_X64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+#endif
+#endif
+
+namespace
+{
+   constexpr size_t ROW_ALIGNMENT = BucketForGuessTable::ROW_ALIGNMENT;
+   constexpr size_t GATHER_PADDING = BucketForGuessTable::GATHER_PADDING;
+   constexpr int BLOCK_SIZE = 256; // answers handled together by `buildFast`
+
+   void gatherRowScalar( const uint8_t* row, std::span<const int> answers, uint8_t* out )
+   {
+      for ( size_t i = 0; i < answers.size(); i++ )
+         out[i] = row[answers[i]];
+   }
+
+#ifdef WORDLE_X64
+   bool cpuHasAvx2()
+   {
+#ifdef _MSC_VER
+      int info[4];
+      __cpuid( info, 1 );
+      bool osUsesAvx = ( info[2] & ( 1 << 27 ) ) && ( info[2] & ( 1 << 28 ) ) && ( _xgetbv( 0 ) & 6 ) == 6;
+      __cpuidex( info, 7, 0 );
+      return osUsesAvx && ( info[1] & ( 1 << 5 ) );
+#else
+      return __builtin_cpu_supports( "avx2" );
+#endif
+   }
+
+   TARGET_AVX2 void gatherRowAvx2( const uint8_t* row, std::span<const int> answers, uint8_t* out )
+   {
+      const __m256i lowBytes = _mm256_set1_epi32( 0xff );
+      size_t i = 0;
+      for ( ; i + 8 <= answers.size(); i += 8 )
+      {
+         __m256i indices = _mm256_loadu_si256( (const __m256i*) &answers[i] );
+         __m256i words = _mm256_and_si256( _mm256_i32gather_epi32( (const int*) row, indices, 1 ), lowBytes );
+         // 8 x int32 -> 8 x uint8 (each 128-bit lane packs its own 4 values into its low 4 bytes)
+         __m256i packed = _mm256_packus_epi16( _mm256_packus_epi32( words, words ), words );
+         uint32_t lo = (uint32_t) _mm_cvtsi128_si32( _mm256_castsi256_si128( packed ) );
+         uint32_t hi = (uint32_t) _mm_cvtsi128_si32( _mm256_extracti128_si256( packed, 1 ) );
+         memcpy( out + i, &lo, 4 );
+         memcpy( out + i + 4, &hi, 4 );
+      }
+      gatherRowScalar( row, answers.subspan( i ), out + i );
+   }
+
+   const auto s_gatherRow = cpuHasAvx2() ? gatherRowAvx2 : gatherRowScalar;
+#else
+   const auto s_gatherRow = gatherRowScalar;
+#endif
+}
+
+int calcBucketForGuess( const std::string& guess, const std::string& answer )
+{
+   int otherLetters[26] = { 0 };
+   int buckets[WORD_LEN] = { 0 };
+   for ( int i = 0; i < WORD_LEN; i++ )
+      if ( guess[i] == answer[i] )
+         buckets[i] = 1;
+      else
+         otherLetters[answer[i]-'a']++;
+   for ( int i = 0; i < WORD_LEN; i++ )
+      if ( guess[i] != answer[i] )
+         if ( otherLetters[guess[i]-'a']-- > 0 )
+            buckets[i] = 2;
+
+   int ret = 0;
+   for ( int i = 0; i < WORD_LEN; i++ )
+      ret = ret * 3 + buckets[i];
+   return ret;
+}
+
+std::string bucketToStr( int bucket )
+{
+   std::string ret;
+   for ( int i = 0; i < WORD_LEN; i++, bucket /= 3 )
+   {
+      int bucketType = bucket % 3;
+      ret += std::string("_#~")[bucketType];
+   }
+   std::reverse( ret.begin(), ret.end() );
+   return ret;
+}
+
+int strToBucket( std::string_view str )
+{
+   if ( str.size() != WORD_LEN )
+      return -1;
+   int ret = 0;
+   for ( char c : str )
+   {
+      size_t bucketType = std::string_view( "_#~" ).find( c );
+      if ( bucketType == std::string_view::npos )
+         return -1;
+      ret = ret * 3 + (int) bucketType;
+   }
+   return ret;
+}
+
+void BucketForGuessTable::AlignedDelete::operator()( uint8_t* p ) const
+{
+   ::operator delete[]( p, std::align_val_t( ROW_ALIGNMENT ) );
+}
+
+BucketForGuessTable::BucketForGuessTable( const std::vector<std::string>& words, int numAnswers, Builder builder )
+{
+   _numGuesses = (int) words.size();
+   _numAnswers = numAnswers;
+   _stride = ( _numAnswers + ROW_ALIGNMENT - 1 ) / ROW_ALIGNMENT * ROW_ALIGNMENT;
+   size_t numBytes = _numGuesses * _stride + GATHER_PADDING;
+   _buckets.reset( new ( std::align_val_t( ROW_ALIGNMENT ) ) uint8_t[numBytes]() );
+   _data = _buckets.get();
+   _rowCapacity = _numGuesses;
+
+   if ( builder == Builder::Fast )
+      buildFast( words );
+   else
+      buildReference( words );
+}
+
+BucketForGuessTable BucketForGuessTable::view( const uint8_t* buckets, int numGuesses, int numAnswers, size_t stride )
+{
+   BucketForGuessTable ret;
+   ret._data = buckets;
+   ret._numGuesses = numGuesses;
+   ret._numAnswers = numAnswers;
+   ret._stride = stride;
+   return ret;
+}
+
+void BucketForGuessTable::grow( const std::vector<std::string>& words, int numAnswers )
+{
+   int numGuesses = (int) words.size();
+   if ( !_buckets && _numGuesses > 0 )
+      throw "in `BucketForGuessTable::grow`: can't grow a view";
+   if ( numGuesses < _numGuesses || numAnswers < _numAnswers || numAnswers > numGuesses )
+      throw "in `BucketForGuessTable::grow`: the table can only grow";
+
+   size_t stride = ( numAnswers + ROW_ALIGNMENT - 1 ) / ROW_ALIGNMENT * ROW_ALIGNMENT;
+   if ( stride != _stride || numGuesses > _rowCapacity )
+   {
+      // leave room for a cache line's worth of new rows, so growing one word at a time rarely reallocates
+      int rowCapacity = int( ( numGuesses + ROW_ALIGNMENT - 1 ) / ROW_ALIGNMENT * ROW_ALIGNMENT );
+      std::unique_ptr<uint8_t[], AlignedDelete> buckets( new ( std::align_val_t( ROW_ALIGNMENT ) ) uint8_t[rowCapacity * stride + GATHER_PADDING]() );
+      for ( int guess = 0; guess < _numGuesses; guess++ )
+         std::copy_n( row( guess ), _numAnswers, &buckets[guess * stride] );
+      _buckets = std::move( buckets );
+      _data = _buckets.get();
+      _stride = stride;
+      _rowCapacity = rowCapacity;
+   }
+
+   for ( int guess = 0; guess < numGuesses; guess++ )
+      for ( int answer = guess < _numGuesses ? _numAnswers : 0; answer < numAnswers; answer++ )
+         _buckets[guess * _stride + answer] = (uint8_t) calcBucketForGuess( words[guess], words[answer] );
+   _numGuesses = numGuesses;
+   _numAnswers = numAnswers;
+}
+
+void BucketForGuessTable::buildReference( const std::vector<std::string>& words )
+{
+   for ( int a = 0; a < _numGuesses; a++ )
+      for ( int b = 0; b < _numAnswers; b++ )
+         _buckets[a * _stride + b] = (uint8_t) calcBucketForGuess( words[a], words[b] );
+}
+
+// same result as `calcBucketForGuess`, but computed one guess against all answers at once:
+// a letter that isn't correct is "present" if the answer has more unmatched copies of it than the guess used up in earlier positions
+// every step is a plain elementwise operation over the answers, so the compiler can vectorize it
+void BucketForGuessTable::buildFast( const std::vector<std::string>& words )
+{
+   // letters[i * paddedSize + answer] = letter index at position i (structure of arrays, so each position is contiguous)
+   // padded to whole blocks, so the inner loops have a fixed trip count
+   int paddedSize = std::max( _numGuesses, ( _numAnswers + BLOCK_SIZE - 1 ) / BLOCK_SIZE * BLOCK_SIZE );
+   std::vector<uint8_t> letters( WORD_LEN * paddedSize );
+   for ( int i = 0; i < WORD_LEN; i++ )
+      for ( int w = 0; w < _numGuesses; w++ )
+         letters[i * paddedSize + w] = uint8_t( words[w][i] - 'a' );
+
+   parallelFor( _numGuesses, [&]( int guess )
+   {
+      uint8_t guessLetters[WORD_LEN];
+      for ( int i = 0; i < WORD_LEN; i++ )
+         guessLetters[i] = letters[i * paddedSize + guess];
+
+      uint8_t* row = &_buckets[guess * _stride];
+      for ( int blockStart = 0; blockStart < _numAnswers; blockStart += BLOCK_SIZE )
+      {
+         uint8_t answerLetters[WORD_LEN][BLOCK_SIZE];
+         for ( int i = 0; i < WORD_LEN; i++ )
+            std::copy_n( &letters[i * paddedSize + blockStart], BLOCK_SIZE, answerLetters[i] );
+
+         uint8_t isUnmatched[WORD_LEN][BLOCK_SIZE];
+         for ( int i = 0; i < WORD_LEN; i++ )
+            for ( int a = 0; a < BLOCK_SIZE; a++ )
+               isUnmatched[i][a] = answerLetters[i][a] != guessLetters[i];
+
+         uint8_t bucket[BLOCK_SIZE] = { 0 };
+         for ( int i = 0; i < WORD_LEN; i++ )
+         {
+            uint8_t numUnmatchedInAnswer[BLOCK_SIZE] = { 0 };
+            for ( int k = 0; k < WORD_LEN; k++ )
+               for ( int a = 0; a < BLOCK_SIZE; a++ )
+                  numUnmatchedInAnswer[a] += isUnmatched[k][a] & ( answerLetters[k][a] == guessLetters[i] );
+
+            uint8_t numUsedByGuess[BLOCK_SIZE] = { 0 };
+            for ( int j = 0; j < i; j++ ) if ( guessLetters[j] == guessLetters[i] )
+               for ( int a = 0; a < BLOCK_SIZE; a++ )
+                  numUsedByGuess[a] += isUnmatched[j][a];
+
+            for ( int a = 0; a < BLOCK_SIZE; a++ )
+            {
+               uint8_t isPresent = isUnmatched[i][a] & ( numUnmatchedInAnswer[a] > numUsedByGuess[a] );
+               bucket[a] = bucket[a] * 3 + ( 1 - isUnmatched[i][a] ) + 2 * isPresent;
+            }
+         }
+         std::copy_n( bucket, std::min( BLOCK_SIZE, _numAnswers - blockStart ), row + blockStart );
+      }
+   } );
+}
+
+bool BucketForGuessTable::operator==( const BucketForGuessTable& rhs ) const
+{
+   if ( _numGuesses != rhs._numGuesses || _numAnswers != rhs._numAnswers )
+      return false;
+   for ( int guess = 0; guess < _numGuesses; guess++ )
+      if ( !std::equal( row( guess ), row( guess ) + _numAnswers, rhs.row( guess ) ) )
+         return false;
+   return true;
+}
+
+void BucketForGuessTable::gatherRow( int guess, std::span<const int> answers, uint8_t* out ) const
+{
+   s_gatherRow( row( guess ), answers, out );
+}
+
+BucketSet bucketHistogram( std::span<const uint8_t> buckets, int* wordsInBucket )
+{
+   BucketSet usedBuckets;
+   for ( uint8_t bucket : buckets )
+   {
+      wordsInBucket[bucket]++;
+      usedBuckets.insert( bucket );
+   }
+   return usedBuckets;
+}
+
+bool allBucketsDistinct( std::span<const uint8_t> buckets )
+{
+   if ( buckets.size() > NUM_BUCKETS )
+      return false;
+   BucketSet usedBuckets;
+   for ( uint8_t bucket : buckets )
+   {
+      if ( usedBuckets.contains( bucket ) )
+         return false;
+      usedBuckets.insert( bucket );
+   }
+   return true;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+constexpr int WORD_LEN = 5;
+
+// 3^n
+constexpr int pow3( int n ) { return n == 0 ? 1 : 3 * pow3( n-1 ); }
+
+constexpr int NUM_BUCKETS = pow3( WORD_LEN );
+constexpr int CORRECT_ANSWER_BUCKET = ( NUM_BUCKETS - 1 ) / 2; // every digit 1
+static_assert( NUM_BUCKETS <= 256, "buckets are stored as uint8_t" );
+
+// the feedback for `guess` when the answer is `answer`, as a base-3 number (one digit per letter: 0 = absent, 1 = correct, 2 = present)
+int calcBucketForGuess( const std::string& guess, const std::string& answer );
+
+// a bucket written as one character per letter: '_' = absent, '#' = correct, '~' = present (e.g. "__#~_")
+std::string bucketToStr( int bucket );
+// inverse of `bucketToStr`, or -1 if `str` isn't a valid bucket
+int strToBucket( std::string_view str );
+
+// bucket (i.e. feedback) for every guess/answer pair of a dictionary
+// every word can be guessed, but only the first `numAnswers` words can be answers (so an answer's index is the same as a guess and as an answer)
+// stored as one contiguous, row-major buffer (one row per guess, one column per answer), with each row padded to a cache line
+class BucketForGuessTable
+{
+public:
+   enum class Builder
+   {
+      Fast,      // words encoded once as letter indices, rows built on all threads, inner loop vectorizable across answers
+      Reference, // plain `calcBucketForGuess` for every pair (for checking and benchmarking `Fast`)
+   };
+
+   BucketForGuessTable() = default;
+   explicit BucketForGuessTable( const std::vector<std::string>& words, Builder builder = Builder::Fast ) : BucketForGuessTable( words, (int) words.size(), builder ) {}
+   BucketForGuessTable( const std::vector<std::string>& words, int numAnswers, Builder builder = Builder::Fast );
+
+   // non-owning table over memory that outlives it (e.g. a memory-mapped file)
+   // rows are `stride` bytes apart, and `GATHER_PADDING` readable bytes must follow the last row
+   static BucketForGuessTable view( const uint8_t* buckets, int numGuesses, int numAnswers, size_t stride );
+
+   // extends the table to a bigger dictionary whose words start with the words the table was built for (so existing entries keep their indices)
+   // only the new rows and columns are computed; the buffer is reallocated only when a new row or column doesn't fit
+   void grow( const std::vector<std::string>& words, int numAnswers );
+
+   static constexpr size_t ROW_ALIGNMENT = 64;
+   static constexpr size_t GATHER_PADDING = 3; // `gatherRow` may read up to 4 bytes at a time
+
+   uint8_t bucket( int guess, int answer ) const { return _data[guess * _stride + answer]; }
+   const uint8_t* row( int guess ) const { return &_data[guess * _stride]; }
+   int numGuesses() const { return _numGuesses; }
+   int numAnswers() const { return _numAnswers; }
+   size_t stride() const { return _stride; }
+   bool operator==( const BucketForGuessTable& rhs ) const;
+
+   // gathered layout: writes `bucket( guess, answers[i] )` to `out[i]`, so the buckets for a candidate list can be scanned contiguously
+   void gatherRow( int guess, std::span<const int> answers, uint8_t* out ) const;
+
+private:
+   struct AlignedDelete { void operator()( uint8_t* p ) const; };
+
+   void buildFast( const std::vector<std::string>& words );
+   void buildReference( const std::vector<std::string>& words );
+
+   std::unique_ptr<uint8_t[], AlignedDelete> _buckets; // null for views
+   const uint8_t* _data = nullptr;
+   size_t _stride = 0;
+   int _rowCapacity = 0; // rows allocated in `_buckets`
+   int _numGuesses = 0;
+   int _numAnswers = 0;
+};
+
+// a set of buckets, as a bitset -- lets the search visit just the buckets a guess uses, instead of scanning all NUM_BUCKETS of them
+class BucketSet
+{
+public:
+   void insert( int bucket ) { _bits[bucket / 64] |= 1ULL << ( bucket % 64 ); }
+   void erase( int bucket ) { _bits[bucket / 64] &= ~( 1ULL << ( bucket % 64 ) ); }
+   bool contains( int bucket ) const { return _bits[bucket / 64] >> ( bucket % 64 ) & 1; }
+   int size() const;
+
+   // calls `fn( bucket )` for each bucket in the set, in increasing order
+   template<typename Fn>
+   void forEach( Fn fn ) const
+   {
+      for ( int i = 0; i < NUM_WORDS; i++ )
+         for ( uint64_t bits = _bits[i]; bits != 0; bits &= bits - 1 )
+            fn( i * 64 + std::countr_zero( bits ) );
+   }
+
+private:
+   static constexpr int NUM_WORDS = ( NUM_BUCKETS + 63 ) / 64;
+   uint64_t _bits[NUM_WORDS] = { 0 };
+};
+
+inline int BucketSet::size() const
+{
+   int size = 0;
+   for ( uint64_t bits : _bits )
+      size += std::popcount( bits );
+   return size;
+}
+
+// adds the number of occurrences of each bucket in `buckets` to `wordsInBucket` (which has NUM_BUCKETS entries), and returns the buckets that occur
+BucketSet bucketHistogram( std::span<const uint8_t> buckets, int* wordsInBucket );
+
+// true if no bucket occurs twice in `buckets`
+bool allBucketsDistinct( std::span<const uint8_t> buckets );
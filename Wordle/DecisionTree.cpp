@@ -0,0 +1,26 @@
+#include "DecisionTree.h"
+
+#include <algorithm>
+
+DecisionTree::DecisionTree( std::vector<Node> nodes, std::vector<Child> children, double score )
+   : _ownedNodes( std::move( nodes ) ), _ownedChildren( std::move( children ) ), _nodes( _ownedNodes ), _children( _ownedChildren ), _score( score )
+{
+}
+
+DecisionTree DecisionTree::view( std::span<const Node> nodes, std::span<const Child> children, double score )
+{
+   DecisionTree ret;
+   ret._nodes = nodes;
+   ret._children = children;
+   ret._score = score;
+   return ret;
+}
+
+int DecisionTree::child( int node, int bucket ) const
+{
+   std::span<const Child> nodeChildren = children( node );
+   auto it = std::lower_bound( nodeChildren.begin(), nodeChildren.end(), bucket, []( const Child& child, int bucket ) { return child.bucket < bucket; } );
+   if ( it == nodeChildren.end() || it->bucket != bucket )
+      return -2;
+   return it->node;
+}
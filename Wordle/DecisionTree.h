@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// a solved search tree, stored as flat arrays
+// each node is a guess; its children (one per bucket the remaining candidates fall into) are a contiguous range of `children`, sorted by bucket
+// node 0 is the root
+class DecisionTree
+{
+public:
+   struct Node
+   {
+      int32_t guess;
+      int32_t firstChild;
+      int32_t numChildren;
+   };
+   struct Child
+   {
+      int32_t bucket;
+      int32_t node; // -1 when `bucket` is CORRECT_ANSWER_BUCKET (i.e. solved)
+   };
+
+   DecisionTree() = default;
+   DecisionTree( std::vector<Node> nodes, std::vector<Child> children, double score );
+   DecisionTree( DecisionTree&& ) = default;
+   DecisionTree& operator=( DecisionTree&& ) = default;
+
+   // non-owning tree over arrays that outlive it (e.g. a memory-mapped file)
+   static DecisionTree view( std::span<const Node> nodes, std::span<const Child> children, double score );
+
+   std::span<const Node> nodes() const { return _nodes; }
+   std::span<const Child> children() const { return _children; }
+   const Node& node( int node ) const { return _nodes[node]; }
+   std::span<const Child> children( int node ) const { return _children.subspan( _nodes[node].firstChild, _nodes[node].numChildren ); }
+   double score() const { return _score; }
+   bool empty() const { return _nodes.empty(); }
+
+   // the node reached from `node` after getting `bucket` as feedback
+   // returns -1 if the guess was correct, or -2 if `bucket` isn't possible at `node`
+   int child( int node, int bucket ) const;
+
+private:
+   std::vector<Node> _ownedNodes;
+   std::vector<Child> _ownedChildren;
+   std::span<const Node> _nodes;
+   std::span<const Child> _children;
+   double _score = 0;
+};
@@ -0,0 +1,83 @@
+#include "DecisionTreeWriter.h"
+#include "BucketForGuessTable.h"
+
+#include <algorithm>
+#include <climits>
+#include <ostream>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+   constexpr int STEP_LEN = 2 * WORD_LEN + 3; // "guess _~#__  "
+}
+
+DecisionTreeWriter::DecisionTreeWriter( ostream& out, const vector<string>& words ) : _out( out ), _words( words )
+{
+   _buffer.reserve( BUFFER_SIZE );
+}
+
+void DecisionTreeWriter::writeText( const DecisionTree& tree )
+{
+   if ( tree.empty() )
+      return;
+   _numAnswersForNode.assign( tree.nodes().size(), 0 );
+   countAnswers( tree, 0 );
+   writeLines( tree, 0, 0 );
+}
+
+void DecisionTreeWriter::flush()
+{
+   _out.write( _buffer.data(), (streamsize) _buffer.size() );
+   _buffer.clear();
+}
+
+int DecisionTreeWriter::countAnswers( const DecisionTree& tree, int node )
+{
+   int numAnswers = 0;
+   for ( const DecisionTree::Child& child : tree.children( node ) )
+      numAnswers += child.node < 0 ? 1 : countAnswers( tree, child.node );
+   return _numAnswersForNode[node] = numAnswers;
+}
+
+void DecisionTreeWriter::writeLines( const DecisionTree& tree, int node, int depth )
+{
+   const string& guess = _words[tree.node( node ).guess];
+   span<const DecisionTree::Child> children = tree.children( node );
+
+   // (the correct guess's "child" has no node, and counts as the largest -- ties keep the bucket order)
+   int order[NUM_BUCKETS];
+   int numChildren = (int) children.size();
+   for ( int i = 0; i < numChildren; i++ )
+      order[i] = i;
+   auto size = [&]( int i ) { return children[i].node < 0 ? INT_MAX : _numAnswersForNode[children[i].node]; };
+   sort( order, order + numChildren, [&]( int a, int b ) { return pair( size( b ), a ) < pair( size( a ), b ); } );
+
+   _line.resize( ( depth + 1 ) * STEP_LEN );
+   char* step = &_line[depth * STEP_LEN];
+   copy( guess.begin(), guess.end(), step );
+   step[WORD_LEN] = ' ';
+   step[2*WORD_LEN + 1] = step[2*WORD_LEN + 2] = ' ';
+
+   for ( int i = 0; i < numChildren; i++ )
+   {
+      const DecisionTree::Child& child = children[order[i]];
+      // (as `bucketToStr` writes it: the last letter is the lowest base-3 digit -- and `_line` may have moved while writing the last subtree)
+      char* feedback = &_line[depth * STEP_LEN + WORD_LEN + 1];
+      for ( int j = WORD_LEN - 1, bucket = child.bucket; j >= 0; j--, bucket /= 3 )
+         feedback[j] = "_#~"[bucket % 3];
+      if ( child.node >= 0 )
+      {
+         writeLines( tree, child.node, depth + 1 );
+         continue;
+      }
+
+      // the line ends with this step (without its trailing spaces)
+      size_t lineLen = ( depth + 1 ) * STEP_LEN - 2;
+      if ( _buffer.size() + lineLen + 1 > BUFFER_SIZE )
+         flush();
+      _buffer.append( _line, 0, lineLen );
+      _buffer += '\n';
+   }
+}
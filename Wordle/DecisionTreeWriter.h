@@ -0,0 +1,39 @@
+#pragma once
+
+#include "DecisionTree.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// writes a DecisionTree as text, one line per answer: the guesses and their feedback down to the answer, e.g.
+//    raise _~___  cloud ___~_  ghoul #####
+// (the format `StrategyEvaluation::readTree` reads -- the binary format is SolutionFile)
+// lines are assembled in place and go out in large blocks, so there's no string building per line and no flush until the end
+class DecisionTreeWriter
+{
+public:
+   // `words` are the words the tree's guesses index -- both must outlive the writer
+   DecisionTreeWriter( std::ostream& out, const std::vector<std::string>& words );
+   ~DecisionTreeWriter() { flush(); }
+   DecisionTreeWriter( const DecisionTreeWriter& ) = delete;
+   DecisionTreeWriter& operator=( const DecisionTreeWriter& ) = delete;
+
+   // at each node, the line for the correct guess comes first, then the other buckets' subtrees, largest first
+   void writeText( const DecisionTree& tree );
+
+   // writes out whatever is buffered (without flushing the stream itself)
+   void flush();
+
+private:
+   static constexpr size_t BUFFER_SIZE = 1 << 16;
+
+   void writeLines( const DecisionTree& tree, int node, int depth );
+   int countAnswers( const DecisionTree& tree, int node );
+
+   std::ostream& _out;
+   const std::vector<std::string>& _words;
+   std::string _buffer;
+   std::string _line;                    // the guesses and feedback on the way to the current node
+   std::vector<int> _numAnswersForNode; // for ordering each node's children
+};
@@ -0,0 +1,74 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile( const std::string& path )
+{
+   _file = ::CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+   if ( _file == INVALID_HANDLE_VALUE )
+      throw "in `MappedFile`: can't open file";
+   LARGE_INTEGER size;
+   if ( !::GetFileSizeEx( _file, &size ) )
+   {
+      ::CloseHandle( _file );
+      throw "in `MappedFile`: can't get the file size";
+   }
+   _size = (size_t) size.QuadPart;
+   _mapping = ::CreateFileMappingA( _file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+   if ( !_mapping )
+   {
+      ::CloseHandle( _file );
+      throw "in `MappedFile`: can't map file";
+   }
+   _data = (const uint8_t*) ::MapViewOfFile( _mapping, FILE_MAP_READ, 0, 0, 0 );
+   if ( !_data )
+   {
+      ::CloseHandle( _mapping );
+      ::CloseHandle( _file );
+      throw "in `MappedFile`: can't map file";
+   }
+}
+
+MappedFile::~MappedFile()
+{
+   ::UnmapViewOfFile( _data );
+   ::CloseHandle( _mapping );
+   ::CloseHandle( _file );
+}
+
+#else
+
+MappedFile::MappedFile( const std::string& path )
+{
+   int fd = ::open( path.c_str(), O_RDONLY );
+   if ( fd < 0 )
+      throw "in `MappedFile`: can't open file";
+   struct stat st;
+   if ( ::fstat( fd, &st ) != 0 )
+   {
+      ::close( fd );
+      throw "in `MappedFile`: can't get the file size";
+   }
+   _size = (size_t) st.st_size;
+   void* data = ::mmap( nullptr, _size, PROT_READ, MAP_SHARED, fd, 0 );
+   ::close( fd );
+   if ( data == MAP_FAILED )
+      throw "in `MappedFile`: can't map file";
+   _data = (const uint8_t*) data;
+}
+
+MappedFile::~MappedFile()
+{
+   ::munmap( (void*) _data, _size );
+}
+
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// read-only memory mapping of a whole file (pages are shared between all processes mapping the same file)
+class MappedFile
+{
+public:
+   explicit MappedFile( const std::string& path );
+   ~MappedFile();
+   MappedFile( const MappedFile& ) = delete;
+   MappedFile& operator=( const MappedFile& ) = delete;
+
+   const uint8_t* data() const { return _data; }
+   size_t size() const { return _size; }
+
+private:
+   const uint8_t* _data = nullptr;
+   size_t _size = 0;
+#ifdef _WIN32
+   void* _file = nullptr;
+   void* _mapping = nullptr;
+#endif
+};
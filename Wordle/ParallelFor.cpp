@@ -0,0 +1,112 @@
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+int g_numThreads = std::max( 1, (int) std::thread::hardware_concurrency() );
+
+namespace
+{
+   thread_local bool t_isInParallelFor = false;
+
+   // worker threads that live for the rest of the program, so a `parallelFor` only wakes them up instead of starting new threads
+   // (the search calls it for every big enough subproblem) -- the workers also keep their thread_local search arenas between calls
+   // one loop runs at a time, and idle threads grab the next unclaimed index from it
+   class ThreadPool
+   {
+   public:
+      // the pool is never destroyed: its workers just wait for the next loop until the program exits
+      static ThreadPool& get()
+      {
+         static ThreadPool* pool = new ThreadPool();
+         return *pool;
+      }
+
+      // calls `fn( i )` for each `i` in [0, n) on the calling thread and `numThreads - 1` workers
+      void run( int numThreads, int n, const std::function<void( int )>& fn )
+      {
+         std::lock_guard<std::mutex> runLock( _runMutex );
+         {
+            std::lock_guard<std::mutex> lock( _mutex );
+            while ( (int) _threads.size() < numThreads - 1 )
+               _threads.emplace_back( &ThreadPool::workerLoop, this, (int) _threads.size() );
+            _fn = &fn;
+            _n = n;
+            _nextIndex = 0;
+            _numWorkers = numThreads - 1;
+            _numWorkersBusy = _numWorkers;
+            _loop++;
+         }
+         _loopStarted.notify_all();
+
+         work(); // the calling thread works too
+
+         std::unique_lock<std::mutex> lock( _mutex );
+         _loopFinished.wait( lock, [&]() { return _numWorkersBusy == 0; } );
+         _fn = nullptr;
+      }
+
+   private:
+      void work()
+      {
+         t_isInParallelFor = true;
+         for ( int i = _nextIndex++; i < _n; i = _nextIndex++ )
+            ( *_fn )( i );
+         t_isInParallelFor = false;
+      }
+
+      void workerLoop( int worker )
+      {
+         uint64_t loopsSeen = 0;
+         std::unique_lock<std::mutex> lock( _mutex );
+         for ( ;; )
+         {
+            _loopStarted.wait( lock, [&]() { return _loop != loopsSeen; } );
+            loopsSeen = _loop;
+            if ( worker >= _numWorkers ) // (this loop uses fewer threads)
+               continue;
+
+            lock.unlock();
+            work();
+            lock.lock();
+            if ( --_numWorkersBusy == 0 )
+               _loopFinished.notify_one();
+         }
+      }
+
+      std::mutex _runMutex; // held for a whole loop
+      std::mutex _mutex;    // guards the loop's setup and `_numWorkersBusy`
+      std::condition_variable _loopStarted;
+      std::condition_variable _loopFinished;
+      std::vector<std::thread> _threads;
+      uint64_t _loop = 0; // counts the loops run, so each worker joins each loop once
+      const std::function<void( int )>* _fn = nullptr;
+      int _n = 0;
+      std::atomic<int> _nextIndex = 0;
+      int _numWorkers = 0;     // the workers taking part in the current loop (the first `_numWorkers` of `_threads`)
+      int _numWorkersBusy = 0; // those that haven't finished it yet
+   };
+}
+
+bool isInParallelFor()
+{
+   return t_isInParallelFor;
+}
+
+void parallelFor( int n, const std::function<void( int )>& fn )
+{
+   int numThreads = std::min( g_numThreads, n );
+   if ( numThreads <= 1 || t_isInParallelFor )
+   {
+      for ( int i = 0; i < n; i++ )
+         fn( i );
+      return;
+   }
+
+   ThreadPool::get().run( numThreads, n, fn );
+}
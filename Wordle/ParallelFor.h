@@ -0,0 +1,15 @@
+#pragma once
+
+#include <functional>
+
+// number of threads used by `parallelFor` (1 = single-threaded)
+extern int g_numThreads;
+
+// calls `fn( i )` for each `i` in [0, n), spreading the work across `g_numThreads` threads
+// (idle threads grab the next unclaimed index, so uneven work items are balanced automatically)
+// the threads are started by the first call and reused by every later one
+// nested calls from inside a worker run single-threaded
+void parallelFor( int n, const std::function<void( int )>& fn );
+
+// true when called from inside a `parallelFor` worker
+bool isInParallelFor();
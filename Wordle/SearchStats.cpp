@@ -0,0 +1,169 @@
+#include "SearchStats.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+struct SearchStats::Registry
+{
+   std::mutex mutex;
+   std::vector<ThreadBlock*> liveBlocks;
+   ThreadBlock retiredBlock{}; // sum of the blocks of the threads that have exited (the `parallelFor` workers never do, but other threads might)
+
+   static Registry& get()
+   {
+      static Registry registry;
+      return registry;
+   }
+
+   // owns a thread's block, and folds it into `retiredBlock` when the thread exits
+   struct BlockOwner
+   {
+      std::unique_ptr<ThreadBlock> block = std::make_unique<ThreadBlock>();
+
+      ~BlockOwner()
+      {
+         Registry& registry = get();
+         std::lock_guard<std::mutex> lock( registry.mutex );
+         forEachValue( *block, registry.retiredBlock, []( std::atomic<uint64_t>& from, std::atomic<uint64_t>& to ) { add( to, from.load( std::memory_order_relaxed ) ); } );
+         registry.liveBlocks.erase( std::find( registry.liveBlocks.begin(), registry.liveBlocks.end(), block.get() ) );
+         t_threadBlock = nullptr;
+      }
+   };
+
+   // calls `fn( a.x, b.x )` for each value `x` of the blocks
+   template<typename Fn>
+   static void forEachValue( ThreadBlock& a, ThreadBlock& b, const Fn& fn )
+   {
+      for ( int numGuessesLeft = 0; numGuessesLeft <= MAX_NUM_GUESSES; numGuessesLeft++ )
+      {
+         for ( int counter = 0; counter < NUM_COUNTERS; counter++ )
+            fn( a.counters[numGuessesLeft][counter], b.counters[numGuessesLeft][counter] );
+         for ( int bin = 0; bin < NUM_SIZE_BINS; bin++ )
+            fn( a.sizeHistogram[numGuessesLeft][bin], b.sizeHistogram[numGuessesLeft][bin] );
+         fn( a.nanoseconds[numGuessesLeft], b.nanoseconds[numGuessesLeft] );
+      }
+   }
+};
+
+SearchStats::ThreadBlock& SearchStats::registerThread()
+{
+   thread_local Registry::BlockOwner owner;
+
+   Registry& registry = Registry::get();
+   std::lock_guard<std::mutex> lock( registry.mutex );
+   registry.liveBlocks.push_back( owner.block.get() );
+   t_threadBlock = owner.block.get();
+   return *t_threadBlock;
+}
+
+std::vector<SearchStats::Totals> SearchStats::totals()
+{
+   std::vector<Totals> ret( MAX_NUM_GUESSES+1, Totals{} );
+   auto addBlock = [&ret]( ThreadBlock& block )
+   {
+      for ( int numGuessesLeft = 0; numGuessesLeft <= MAX_NUM_GUESSES; numGuessesLeft++ )
+      {
+         Totals& totals = ret[numGuessesLeft];
+         for ( int counter = 0; counter < NUM_COUNTERS; counter++ )
+            totals.counters[counter] += block.counters[numGuessesLeft][counter].load( std::memory_order_relaxed );
+         for ( int bin = 0; bin < NUM_SIZE_BINS; bin++ )
+            totals.sizeHistogram[bin] += block.sizeHistogram[numGuessesLeft][bin].load( std::memory_order_relaxed );
+         totals.seconds += block.nanoseconds[numGuessesLeft].load( std::memory_order_relaxed ) * 1e-9;
+      }
+   };
+
+   Registry& registry = Registry::get();
+   std::lock_guard<std::mutex> lock( registry.mutex );
+   for ( ThreadBlock* block : registry.liveBlocks )
+      addBlock( *block );
+   addBlock( registry.retiredBlock );
+   return ret;
+}
+
+void SearchStats::reset()
+{
+   auto zero = []( std::atomic<uint64_t>& value, std::atomic<uint64_t>& ) { value.store( 0, std::memory_order_relaxed ); };
+
+   Registry& registry = Registry::get();
+   std::lock_guard<std::mutex> lock( registry.mutex );
+   for ( ThreadBlock* block : registry.liveBlocks )
+      Registry::forEachValue( *block, *block, zero );
+   Registry::forEachValue( registry.retiredBlock, registry.retiredBlock, zero );
+}
+
+void SearchStats::writeReport( std::ostream& out )
+{
+   std::vector<Totals> allTotals = totals();
+   for ( int numGuessesLeft = MAX_NUM_GUESSES; numGuessesLeft >= 0; numGuessesLeft-- )
+   {
+      const Totals& totals = allTotals[numGuessesLeft];
+      if ( totals.counters[CalcScoreCalls] == 0 )
+         continue;
+      out << "search: " << numGuessesLeft << " guesses left:";
+      for ( int counter = 0; counter < NUM_COUNTERS; counter++ )
+         out << " " << COUNTER_NAMES[counter] << " = " << totals.counters[counter] << ",";
+      out << " seconds = " << totals.seconds << ", candidates (by size from 1, 2, 4, ...) =";
+      int numBins = NUM_SIZE_BINS;
+      while ( numBins > 1 && totals.sizeHistogram[numBins-1] == 0 )
+         numBins--;
+      for ( int bin = 0; bin < numBins; bin++ )
+         out << " " << totals.sizeHistogram[bin];
+      out << std::endl;
+   }
+}
+
+void SearchStats::writeJson( std::ostream& out, double elapsedSeconds )
+{
+   TranspositionCache::Stats cacheStats = g_transpositionCache.stats();
+   out << "{\n";
+   out << "  \"instrumentation\": " << ( ENABLED ? "true" : "false" ) << ",\n";
+   out << "  \"elapsedSeconds\": " << elapsedSeconds << ",\n";
+   out << "  \"cache\": { \"hits\": " << cacheStats.hits << ", \"lowerBoundHits\": " << cacheStats.lowerBoundHits << ", \"misses\": " << cacheStats.misses
+       << ", \"stores\": " << cacheStats.stores << ", \"evictions\": " << cacheStats.evictions << " },\n";
+   out << "  \"byGuessesLeft\": [\n";
+
+   std::vector<Totals> allTotals = totals();
+   for ( int numGuessesLeft = MAX_NUM_GUESSES; numGuessesLeft >= 0; numGuessesLeft-- )
+   {
+      const Totals& totals = allTotals[numGuessesLeft];
+      out << "    { \"guessesLeft\": " << numGuessesLeft;
+      for ( int counter = 0; counter < NUM_COUNTERS; counter++ )
+         out << ", \"" << COUNTER_NAMES[counter] << "\": " << totals.counters[counter];
+      out << ", \"seconds\": " << totals.seconds << ", \"candidateCountHistogram\": [";
+      for ( int bin = 0; bin < NUM_SIZE_BINS; bin++ )
+         out << ( bin ? ", " : "" ) << totals.sizeHistogram[bin];
+      out << "] }" << ( numGuessesLeft > 0 ? "," : "" ) << "\n";
+   }
+   out << "  ]\n";
+   out << "}\n";
+}
+
+SearchStats::ProgressReporter::ProgressReporter( std::ostream& out, double intervalSeconds ) : _out( out )
+{
+   _thread = std::thread( [this, intervalSeconds]()
+   {
+      Timer t;
+      std::unique_lock<std::mutex> lock( _mutex );
+      while ( !_stopped.wait_for( lock, std::chrono::duration<double>( intervalSeconds ), [this]() { return _isStopped; } ) )
+      {
+         uint64_t sum[NUM_COUNTERS] = { 0 };
+         for ( const Totals& totals : SearchStats::totals() )
+            for ( int counter = 0; counter < NUM_COUNTERS; counter++ )
+               sum[counter] += totals.counters[counter];
+         _out << "progress: " << t.elapsedTime() << "s, calcScore calls = " << sum[CalcScoreCalls] << ", nodes expanded = " << sum[NodesExpanded]
+              << ", guesses scored = " << sum[GuessesScored] << ", cache hits = " << g_transpositionCache.stats().hits << std::endl;
+      }
+   } );
+}
+
+SearchStats::ProgressReporter::~ProgressReporter()
+{
+   {
+      std::lock_guard<std::mutex> lock( _mutex );
+      _isStopped = true;
+   }
+   _stopped.notify_one();
+   _thread.join();
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// off by default -- build with WORDLE_INSTRUMENTATION=1 to compile the counting into the search
+// (it reads the clock twice per expanded node, on top of the counters: within the run-to-run noise of the calcScore benchmark, a few
+// percent at most, but not free)
+#ifndef WORDLE_INSTRUMENTATION
+#define WORDLE_INSTRUMENTATION 0
+#endif
+
+// instrumentation for `calcScore`: counters, a histogram of the candidate counts, and the time spent, for each number of guesses left
+// each thread counts into its own block (relaxed atomics that are never contended), and the blocks are only summed when reporting
+class SearchStats
+{
+public:
+   static constexpr bool ENABLED = WORDLE_INSTRUMENTATION;
+
+   enum Counter
+   {
+      CalcScoreCalls,
+      CacheHits,
+      OptimalGuessHits,     // subproblems solved by `optimalGuess`, without a search
+      NodesExpanded,        // subproblems whose guesses had to be scored
+      GuessesScored,
+      GuessesPrunedByBound, // dropped by their lower bound before recursing into any bucket
+      GuessesCutOff,        // abandoned part way through their buckets
+      EarlyBreaks,          // searches stopped early by a guess no other guess can beat
+      NUM_COUNTERS
+   };
+   static constexpr const char* COUNTER_NAMES[NUM_COUNTERS] = {
+      "calcScoreCalls", "cacheHits", "optimalGuessHits", "nodesExpanded", "guessesScored", "guessesPrunedByBound", "guessesCutOff", "earlyBreaks" };
+
+   // candidate counts are binned by bit width: 1, 2-3, 4-7, 8-15, ...
+   static constexpr int NUM_SIZE_BINS = 16;
+
+   struct Totals
+   {
+      uint64_t counters[NUM_COUNTERS];
+      uint64_t sizeHistogram[NUM_SIZE_BINS];
+      double seconds; // inclusive of the subproblems below
+   };
+
+   static void count( Counter counter, int numGuessesLeft );
+   static void countCandidates( size_t numCandidateWords, int numGuessesLeft );
+
+   // adds the time until it goes out of scope to `numGuessesLeft`
+   class ScopedTimer
+   {
+   public:
+      explicit ScopedTimer( int numGuessesLeft ) : _numGuessesLeft( numGuessesLeft ), _startTime( std::chrono::steady_clock::now() ) {}
+      ~ScopedTimer();
+
+   private:
+      int _numGuessesLeft;
+      std::chrono::steady_clock::time_point _startTime;
+   };
+
+   // totals over all threads, indexed by the number of guesses left
+   static std::vector<Totals> totals();
+   static void reset();
+
+   // one line per number of guesses left that saw any calls
+   static void writeReport( std::ostream& out );
+   // the per-depth totals and the transposition cache stats, as JSON
+   static void writeJson( std::ostream& out, double elapsedSeconds );
+
+   // prints a progress line to `out` every `intervalSeconds` until it goes out of scope
+   class ProgressReporter
+   {
+   public:
+      ProgressReporter( std::ostream& out, double intervalSeconds );
+      ~ProgressReporter();
+
+   private:
+      std::ostream& _out;
+      std::mutex _mutex;
+      std::condition_variable _stopped;
+      bool _isStopped = false;
+      std::thread _thread;
+   };
+
+private:
+   struct ThreadBlock
+   {
+      std::atomic<uint64_t> counters[MAX_NUM_GUESSES+1][NUM_COUNTERS];
+      std::atomic<uint64_t> sizeHistogram[MAX_NUM_GUESSES+1][NUM_SIZE_BINS];
+      std::atomic<uint64_t> nanoseconds[MAX_NUM_GUESSES+1];
+   };
+
+   struct Registry; // every thread's block (see SearchStats.cpp)
+
+   // this thread's block (registered on first use, and folded into the retired totals when the thread exits)
+   static ThreadBlock& threadBlock() { return t_threadBlock ? *t_threadBlock : registerThread(); }
+   static ThreadBlock& registerThread();
+   static inline thread_local ThreadBlock* t_threadBlock = nullptr;
+
+   static void add( std::atomic<uint64_t>& value, uint64_t amount ) { value.store( value.load( std::memory_order_relaxed ) + amount, std::memory_order_relaxed ); }
+};
+
+#if WORDLE_INSTRUMENTATION
+#define SEARCH_STATS_COUNT( counter, numGuessesLeft ) SearchStats::count( SearchStats::counter, numGuessesLeft )
+#define SEARCH_STATS_COUNT_CANDIDATES( numCandidateWords, numGuessesLeft ) SearchStats::countCandidates( numCandidateWords, numGuessesLeft )
+#define SEARCH_STATS_TIME( numGuessesLeft ) SearchStats::ScopedTimer searchStatsTimer( numGuessesLeft )
+#else
+#define SEARCH_STATS_COUNT( counter, numGuessesLeft ) ( (void) 0 )
+#define SEARCH_STATS_COUNT_CANDIDATES( numCandidateWords, numGuessesLeft ) ( (void) 0 )
+#define SEARCH_STATS_TIME( numGuessesLeft ) ( (void) 0 )
+#endif
+
+inline void SearchStats::count( Counter counter, int numGuessesLeft )
+{
+   add( threadBlock().counters[numGuessesLeft][counter], 1 );
+}
+
+inline void SearchStats::countCandidates( size_t numCandidateWords, int numGuessesLeft )
+{
+   add( threadBlock().sizeHistogram[numGuessesLeft][std::min<int>( std::bit_width( numCandidateWords ) - 1, NUM_SIZE_BINS - 1 )], 1 );
+}
+
+inline SearchStats::ScopedTimer::~ScopedTimer()
+{
+   add( threadBlock().nanoseconds[_numGuessesLeft], std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - _startTime ).count() );
+}
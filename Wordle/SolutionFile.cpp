@@ -0,0 +1,108 @@
+#include "SolutionFile.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+   constexpr char MAGIC[8] = { 'W', 'O', 'R', 'D', 'L', 'E', 'S', 'F' };
+   constexpr uint64_t SECTION_ALIGNMENT = 64;
+
+   uint64_t align( uint64_t offset )
+   {
+      return ( offset + SECTION_ALIGNMENT - 1 ) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+   }
+
+   // true if the `size` bytes at `offset` are all within the file (without overflowing on garbage offsets)
+   bool isInFile( uint64_t offset, uint64_t size, uint64_t fileSize )
+   {
+      return offset <= fileSize && size <= fileSize - offset;
+   }
+}
+
+void SolutionFile::write( const std::string& path, const std::vector<std::string>& words, int numAnswers, int numGuesses, Objective objective,
+                          const BucketForGuessTable& table, const DecisionTree& tree )
+{
+   if ( table.numAnswers() != numAnswers )
+      throw "in `SolutionFile::write`: the table must have one column per answer (hard mode tables have more)";
+
+   Header header = {};
+   memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+   header.version = VERSION;
+   header.wordLen = WORD_LEN;
+   header.numWords = (uint32_t) words.size();
+   header.numAnswers = (uint32_t) numAnswers;
+   header.numGuesses = (uint32_t) numGuesses;
+   header.objective = (uint32_t) objective;
+   header.numNodes = (uint32_t) tree.nodes().size();
+   header.numChildren = (uint32_t) tree.children().size();
+   header.score = tree.score();
+   header.wordsOffset = align( sizeof( Header ) );
+   header.tableOffset = align( header.wordsOffset + words.size() * WORD_LEN );
+   header.tableStride = table.stride();
+   header.nodesOffset = align( header.tableOffset + words.size() * table.stride() + BucketForGuessTable::GATHER_PADDING );
+   header.childrenOffset = align( header.nodesOffset + tree.nodes().size_bytes() );
+   header.fileSize = header.childrenOffset + tree.children().size_bytes();
+
+   std::ofstream out( path, std::ios::binary | std::ios::trunc );
+   if ( !out )
+      throw "in `SolutionFile::write`: can't create file";
+   auto seek = [&]( uint64_t offset ) { out.seekp( (std::streamoff) offset ); };
+
+   out.write( (const char*) &header, sizeof( header ) );
+   seek( header.wordsOffset );
+   for ( const std::string& word : words )
+      out.write( word.data(), WORD_LEN );
+   seek( header.tableOffset );
+   out.write( (const char*) table.row( 0 ), words.size() * table.stride() + BucketForGuessTable::GATHER_PADDING );
+   seek( header.nodesOffset );
+   out.write( (const char*) tree.nodes().data(), tree.nodes().size_bytes() );
+   seek( header.childrenOffset );
+   out.write( (const char*) tree.children().data(), tree.children().size_bytes() );
+   if ( !out )
+      throw "in `SolutionFile::write`: write failed";
+}
+
+SolutionFile::SolutionFile( const std::string& path ) : _file( std::make_unique<MappedFile>( path ) )
+{
+   if ( _file->size() < sizeof( Header ) )
+      throw "in `SolutionFile`: file too small";
+   Header header;
+   memcpy( &header, _file->data(), sizeof( header ) );
+   if ( memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) != 0 )
+      throw "in `SolutionFile`: not a solution file";
+   if ( header.version != VERSION || header.wordLen != WORD_LEN )
+      throw "in `SolutionFile`: incompatible version";
+   if ( header.fileSize != _file->size() )
+      throw "in `SolutionFile`: file is truncated";
+   if ( header.numGuesses < 1 || header.numGuesses > MAX_NUM_GUESSES || header.objective > (uint32_t) Objective::WorstCase )
+      throw "in `SolutionFile`: invalid guess limit or objective";
+
+   // every section must lie within the file (and the tree's sections must be aligned for their types)
+   if ( header.numAnswers > header.numWords || header.tableStride < header.numAnswers || header.tableStride > header.fileSize )
+      throw "in `SolutionFile`: invalid table size";
+   if ( !isInFile( header.wordsOffset, (uint64_t) header.numWords * WORD_LEN, header.fileSize )
+     || !isInFile( header.tableOffset, header.numWords * header.tableStride + BucketForGuessTable::GATHER_PADDING, header.fileSize )
+     || !isInFile( header.nodesOffset, header.numNodes * sizeof( DecisionTree::Node ), header.fileSize )
+     || !isInFile( header.childrenOffset, header.numChildren * sizeof( DecisionTree::Child ), header.fileSize )
+     || header.nodesOffset % alignof( DecisionTree::Node ) != 0 || header.childrenOffset % alignof( DecisionTree::Child ) != 0 )
+      throw "in `SolutionFile`: a section is outside the file";
+
+   const uint8_t* data = _file->data();
+   for ( uint32_t i = 0; i < header.numWords; i++ )
+      _words.emplace_back( (const char*) data + header.wordsOffset + i * WORD_LEN, WORD_LEN );
+   _table = BucketForGuessTable::view( data + header.tableOffset, (int) header.numWords, (int) header.numAnswers, header.tableStride );
+   _tree = DecisionTree::view( { (const DecisionTree::Node*) ( data + header.nodesOffset ), header.numNodes },
+                               { (const DecisionTree::Child*) ( data + header.childrenOffset ), header.numChildren }, header.score );
+   _numGuesses = (int) header.numGuesses;
+   _objective = (Objective) header.objective;
+
+   // every index in the tree must be in range, so following it can't read outside the file
+   for ( const DecisionTree::Node& node : _tree.nodes() )
+      if ( node.guess < 0 || node.guess >= (int64_t) header.numWords || node.firstChild < 0 || node.numChildren < 0
+        || (int64_t) node.firstChild + node.numChildren > header.numChildren )
+         throw "in `SolutionFile`: a node is out of range";
+   for ( const DecisionTree::Child& child : _tree.children() )
+      if ( child.node < -1 || child.node >= (int64_t) header.numNodes || child.bucket < 0 || child.bucket >= NUM_BUCKETS )
+         throw "in `SolutionFile`: a child is out of range";
+}
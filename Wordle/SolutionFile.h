@@ -0,0 +1,69 @@
+#pragma once
+
+#include "BucketForGuessTable.h"
+#include "DecisionTree.h"
+#include "MappedFile.h"
+#include "Solver.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// versioned binary file holding a dictionary, its BucketForGuessTable and its solved DecisionTree (with the guess limit and
+// objective it was solved for)
+// the table and the tree are used straight from the memory-mapped file (no copying), so loading is instant
+// and every process that opens the same file shares its pages
+//
+// layout (little-endian, each section starts on a 64-byte boundary):
+//    Header
+//    words       numWords * WORD_LEN chars (every guess; the first `numAnswers` are the possible answers)
+//    table       numWords rows of `tableStride` bytes (one column per answer), followed by BucketForGuessTable::GATHER_PADDING bytes
+//    nodes       numNodes * DecisionTree::Node
+//    children    numChildren * DecisionTree::Child
+class SolutionFile
+{
+public:
+   static constexpr uint32_t VERSION = 3;
+
+   static void write( const std::string& path, const std::vector<std::string>& words, int numAnswers, int numGuesses, Objective objective,
+                      const BucketForGuessTable& table, const DecisionTree& tree );
+
+   // throws if the file is missing, truncated, was written by an incompatible version, or is inconsistent (a section outside
+   // the file, or a tree index out of range) -- the table's buckets themselves aren't checked, as that would read the whole file
+   explicit SolutionFile( const std::string& path );
+
+   const std::vector<std::string>& words() const { return _words; }
+   int numAnswers() const { return _table.numAnswers(); }
+   const BucketForGuessTable& table() const { return _table; }
+   const DecisionTree& tree() const { return _tree; }
+   int numGuesses() const { return _numGuesses; }
+   Objective objective() const { return _objective; }
+
+private:
+   struct Header
+   {
+      char magic[8];
+      uint32_t version;
+      uint32_t wordLen;
+      uint32_t numWords;
+      uint32_t numNodes;
+      uint32_t numChildren;
+      uint32_t numAnswers;
+      uint32_t numGuesses;
+      uint32_t objective;
+      double score;
+      uint64_t wordsOffset;
+      uint64_t tableOffset;
+      uint64_t tableStride;
+      uint64_t nodesOffset;
+      uint64_t childrenOffset;
+      uint64_t fileSize;
+   };
+
+   std::unique_ptr<MappedFile> _file;
+   std::vector<std::string> _words;
+   BucketForGuessTable _table;
+   DecisionTree _tree;
+   int _numGuesses;
+   Objective _objective;
+};
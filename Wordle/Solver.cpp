@@ -0,0 +1,1047 @@
+#include "Solver.h"
+#include "ParallelFor.h"
+#include "SearchStats.h"
+#include "WordleDictionary.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cmath>
+#include <mutex>
+#include <utility>
+
+using namespace std;
+
+constexpr int MIN_CANDIDATES_FOR_PARALLEL_SEARCH = 100; // smaller searches aren't worth spreading across threads
+
+int g_numGuesses = MAX_NUM_GUESSES;
+vector<string> g_allWords;
+int g_numAnswers = 0;
+bool g_guessFromAllWords = false;
+Objective g_objective = Objective::ExpectedGuesses;
+bool g_hardMode = false;
+BucketForGuessTable g_BucketForGuessTable;
+
+TranspositionCache g_transpositionCache( 512 );
+
+// the most buckets a guess can split the other candidates into: every bucket but CORRECT_ANSWER_BUCKET and the WORD_LEN
+// "all correct but one present" ones (a letter can't be present elsewhere when every other position already matches)
+constexpr int MAX_BUCKETS_PER_GUESS = NUM_BUCKETS - 1 - WORD_LEN;
+
+// g_minTotalGuessesForSize[numGuessesLeft][size] = lower bound on the total number of guesses to find any `size` candidates (see `calcMinScores`)
+vector<double> g_minTotalGuessesForSize[MAX_NUM_GUESSES+1];
+// g_minWorstCaseForSize[numGuessesLeft][size] = lower bound on the most guesses it takes to find one of any `size` candidates
+vector<double> g_minWorstCaseForSize[MAX_NUM_GUESSES+1];
+
+// 0, 1, ..., g_allWords.size()-1 (every guess, for when they aren't limited by hard mode)
+vector<int> g_allGuesses;
+
+// how a guess splits the candidate words (see `guessesToTry`)
+struct GuessPartition
+{
+   uint64_t signature; // hash of the partition (the same for any two guesses that split the candidates the same way)
+   int sumOfSquares;   // sum of the squared bucket sizes (smaller is usually better)
+   int guess;
+   bool isCandidate;
+   bool isDuplicate;
+};
+
+// the number of guesses if every guess split its candidates as finely as possible: the first guess finds one of them, the
+// second at most one per bucket, the third at most one per bucket of a bucket, and so on (INF if they can't all be found in time)
+// precomputed for every size up to the number of answers, since it's needed for every bucket of every guess scored
+void calcMinScores()
+{
+   for ( int numGuessesLeft = 0; numGuessesLeft <= MAX_NUM_GUESSES; numGuessesLeft++ )
+   {
+      vector<double>& minTotalGuessesForSize = g_minTotalGuessesForSize[numGuessesLeft];
+      vector<double>& minWorstCaseForSize = g_minWorstCaseForSize[numGuessesLeft];
+      minTotalGuessesForSize.assign( g_numAnswers + 1, INF );
+      minWorstCaseForSize.assign( g_numAnswers + 1, INF );
+      minTotalGuessesForSize[0] = minWorstCaseForSize[0] = 0;
+      for ( int size = 1; size <= g_numAnswers; size++ )
+      {
+         double totalGuesses = 0;
+         int numLeft = size;
+         int guessNumber = 0;
+         double numFoundByGuess = 1;
+         while ( guessNumber < numGuessesLeft && numLeft > 0 )
+         {
+            guessNumber++;
+            int numFound = (int) min<double>( numLeft, numFoundByGuess );
+            totalGuesses += (double) guessNumber * numFound;
+            numLeft -= numFound;
+            numFoundByGuess *= MAX_BUCKETS_PER_GUESS;
+         }
+         if ( numLeft == 0 )
+         {
+            minTotalGuessesForSize[size] = totalGuesses;
+            minWorstCaseForSize[size] = guessNumber;
+         }
+      }
+   }
+}
+
+// the objectives `calcScore` can minimize (see `Objective`): how a guess's bucket scores combine into its score, and the bounds
+// the search prunes with -- a guess's lower bound starts from `minScore` for each bucket, and tightens as each bucket is solved
+struct ExpectedGuesses
+{
+   // smallest buckets first -- they are cheap to solve exactly, and each one tightens the lower bound, so a guess that can't win
+   // is usually cut off before its big (expensive) buckets are searched
+   static constexpr bool LARGEST_BUCKETS_FIRST = false;
+   // letter frequency order (see `goodOrderForCandidateWords`) -- cheap, and good enough to find a strong guess early
+   static constexpr bool CANDIDATES_BY_FAMILY_SPLIT = false;
+
+   // lower bound on the score of any `size` candidates
+   static double minScore( size_t size, int numGuessesLeft ) { return g_minTotalGuessesForSize[numGuessesLeft][size] / size; }
+   static double scoreForTwoCandidates() { return 1.5; }
+   static double scoreForOptimalGuess( size_t numCandidateWords ) { return 2 - 1./numCandidateWords; }
+   // once `optimalGuess` has failed, the score is at least 2 (a candidate guess leaves two candidates in some bucket, so one of them
+   // takes a third guess), and any score below `unbeatableScore` is as good as it gets
+   static double minScoreWithoutOptimalGuess( size_t numCandidateWords, int numGuessesLeft ) { return max( 2., minScore( numCandidateWords, numGuessesLeft ) ); }
+   static double unbeatableScore( size_t /*numCandidateWords*/, int /*numGuessesLeft*/ ) { return 2.0000001; }
+   static bool onlyPerfectSplitCanBeat( double /*cutoffScore*/ ) { return false; }
+
+   // every candidate takes this guess, and then at least `minScore` more for its bucket
+   static double lowerBoundScoreForGuess( const int* wordsInBucket, const BucketSet& usedBuckets, size_t numCandidateWords, int numGuessesLeftForBuckets )
+   {
+      const double* minTotalGuessesForSize = g_minTotalGuessesForSize[numGuessesLeftForBuckets].data();
+      double minTotalGuesses = 0;
+      usedBuckets.forEach( [&]( int bucket ) { minTotalGuesses += minTotalGuessesForSize[wordsInBucket[bucket]]; } );
+      return 1 + minTotalGuesses / numCandidateWords;
+   }
+   // the score a bucket's subproblem must stay below for its guess to still beat `cutoffScore`
+   // (a little slack is added so rounding can never turn an exact score into a cutoff)
+   static double cutoffScoreForBucket( double cutoffScore, double lowerBoundScore, double minScoreForBucket, size_t bucketSize, size_t numCandidateWords )
+   {
+      return minScoreForBucket + ( cutoffScore - lowerBoundScore ) * numCandidateWords / bucketSize + 1e-9;
+   }
+   static double addScoreForBucket( double lowerBoundScore, double scoreForBucket, double minScoreForBucket, size_t bucketSize, size_t numCandidateWords )
+   {
+      return lowerBoundScore + ( scoreForBucket - minScoreForBucket ) * bucketSize / numCandidateWords;
+   }
+   // summed in bucket order, so the score doesn't depend on the order the buckets were solved in
+   static double scoreForGuess( const double* scoreForBucket, const int* wordsInBucket, const BucketSet& usedBuckets, size_t numCandidateWords, double /*lowerBoundScore*/ )
+   {
+      double score = 1;
+      usedBuckets.forEach( [&]( int bucket ) { score += scoreForBucket[bucket] * wordsInBucket[bucket] / numCandidateWords; } );
+      return score;
+   }
+   static double tightenLowerBound( double lowerBoundScore ) { return lowerBoundScore; }
+};
+
+// scores are whole numbers of guesses, and a guess is cut off as soon as any one bucket reaches the cutoff
+struct WorstCase
+{
+   // the biggest bucket is the one most likely to need the most guesses, i.e. to cut the guess off
+   static constexpr bool LARGEST_BUCKETS_FIRST = true;
+   // most guesses fail a worst case cutoff (see `calcScore`), and refuting one can take a whole subtree, so it pays to try the guesses
+   // most likely to pass first -- those that break up the families of near-identical words (see `candidateWordsByFamilySplit`)
+   static constexpr bool CANDIDATES_BY_FAMILY_SPLIT = true;
+
+   static double minScore( size_t size, int numGuessesLeft ) { return g_minWorstCaseForSize[numGuessesLeft][size]; }
+   static double scoreForTwoCandidates() { return 2; }
+   static double scoreForOptimalGuess( size_t /*numCandidateWords*/ ) { return 2; }
+   // without an optimal guess, every candidate guess leaves a bucket of two or more, which takes two more guesses -- so only a
+   // non-candidate that splits them all up scores 2
+   static double minScoreWithoutOptimalGuess( size_t numCandidateWords, int numGuessesLeft )
+   {
+      return max( g_guessFromAllWords ? 2. : 3., minScore( numCandidateWords, numGuessesLeft ) );
+   }
+   static double unbeatableScore( size_t numCandidateWords, int numGuessesLeft ) { return minScoreWithoutOptimalGuess( numCandidateWords, numGuessesLeft ) + 0.5; }
+   // once `optimalGuess` has failed, beating a cutoff of 3 or less takes a score of 2, i.e. a guess that splits the candidates up
+   // completely (see `perfectSplitGuess`) -- which is most of the nodes a worst case search visits, so they skip scoring every guess
+   static bool onlyPerfectSplitCanBeat( double cutoffScore ) { return cutoffScore <= 3; }
+
+   static double lowerBoundScoreForGuess( const int* wordsInBucket, const BucketSet& usedBuckets, size_t /*numCandidateWords*/, int numGuessesLeftForBuckets )
+   {
+      const double* minWorstCaseForSize = g_minWorstCaseForSize[numGuessesLeftForBuckets].data();
+      double maxMinWorstCase = 0;
+      usedBuckets.forEach( [&]( int bucket ) { maxMinWorstCase = max( maxMinWorstCase, minWorstCaseForSize[wordsInBucket[bucket]] ); } );
+      return 1 + maxMinWorstCase;
+   }
+   static double cutoffScoreForBucket( double cutoffScore, double /*lowerBoundScore*/, double /*minScoreForBucket*/, size_t /*bucketSize*/, size_t /*numCandidateWords*/ )
+   {
+      return cutoffScore - 1;
+   }
+   static double addScoreForBucket( double lowerBoundScore, double scoreForBucket, double /*minScoreForBucket*/, size_t /*bucketSize*/, size_t /*numCandidateWords*/ )
+   {
+      return max( lowerBoundScore, 1 + scoreForBucket );
+   }
+   // (once every bucket is solved, the lower bound is exact)
+   static double scoreForGuess( const double* /*scoreForBucket*/, const int* /*wordsInBucket*/, const BucketSet& /*usedBuckets*/, size_t /*numCandidateWords*/, double lowerBoundScore )
+   {
+      return lowerBoundScore;
+   }
+   // (a search cut off at k + 0.5 -- see `calcScore` -- has shown the score is at least k + 1)
+   static double tightenLowerBound( double lowerBoundScore ) { return ceil( lowerBoundScore ); }
+};
+
+// what the search is instantiated for: the objective, and whether guesses are limited by hard mode
+// in hard mode, a subproblem's words are its candidates followed by the other words still consistent with the feedback (the
+// only other guesses allowed), so the table must have a column for every word (see `numTableColumns`)
+template<typename Objective, bool HardMode>
+struct SearchRules : Objective
+{
+   static constexpr bool HARD_MODE = HardMode;
+   static constexpr int ID = 2 * is_same_v<Objective, WorstCase> + HardMode; // keeps the variants apart in the transposition cache
+};
+
+// hard mode only restricts anything when there are guesses besides the candidates
+bool isHardModeSearch()
+{
+   return g_hardMode && g_guessFromAllWords;
+}
+
+// the answers' columns, plus (for hard mode) the other words', so any word's consistency with the feedback can be looked up
+int numTableColumns()
+{
+   return isHardModeSearch() ? (int) g_allWords.size() : g_numAnswers;
+}
+
+// per-thread scratch space for the search, with one slab per recursion depth (i.e. per `numGuessesLeft`)
+// the slabs only grow, so once they fit the dictionary the search runs without any heap allocations
+class SearchArena
+{
+public:
+   struct Slab
+   {
+      vector<int> partitionedWords; // candidate words grouped by bucket, for the guess currently being scored
+      vector<int> guessOrder;
+      vector<uint8_t> guessBuckets; // `gatherRow` output for the guess currently being scored
+      vector<GuessPartition> guessPartitions; // for ranking/pruning non-candidate guesses (see `guessesToTry`)
+      // for `candidateWordsByFamilySplit`
+      vector<pair<uint32_t, int>> familyKeys; // (the word with one letter masked out, the word)
+      vector<int> familyWords;                // the words of each family in turn
+      vector<int> familyEnds;                 // where each family's words end in `familyWords`
+      vector<uint8_t> familyBuckets;          // `gatherRow` output for `familyWords`
+      vector<pair<uint64_t, int>> guessRanks; // (rank, guess)
+   };
+
+   Slab& slab( int numGuessesLeft )
+   {
+      Slab& slab = _slabs[numGuessesLeft];
+      if ( slab.partitionedWords.size() < g_allWords.size() )
+      {
+         slab.partitionedWords.resize( g_allWords.size() );
+         slab.guessOrder.resize( g_allWords.size() );
+         slab.guessBuckets.resize( g_allWords.size() );
+         slab.guessPartitions.resize( g_allWords.size() );
+         slab.familyKeys.resize( g_allWords.size() );
+         slab.familyWords.resize( WORD_LEN * g_allWords.size() );
+         slab.familyEnds.resize( WORD_LEN * g_allWords.size() );
+         slab.familyBuckets.resize( WORD_LEN * g_allWords.size() );
+         slab.guessRanks.resize( g_allWords.size() );
+      }
+      return slab;
+   }
+
+private:
+   Slab _slabs[MAX_NUM_GUESSES+1];
+};
+
+thread_local SearchArena t_searchArena;
+
+// per number of guesses left, a word from the last bucket that cut a guess off (-1 = none yet) -- for worst case, the bucket holding
+// it is searched first, since whatever made one guess fail (e.g. a group of words differing in one letter) usually sinks its
+// neighbours too (the "killer move" heuristic)
+thread_local array<int, MAX_NUM_GUESSES+1> t_killerWord = []() {
+   array<int, MAX_NUM_GUESSES+1> ret;
+   ret.fill( -1 );
+   return ret;
+}();
+
+// returns -1 if no guess is "optimal" (i.e. putting candidateWords into a separate bucket)
+int optimalGuess( span<const int> candidateWords, int numGuessesLeft )
+{
+   if ( candidateWords.size() > NUM_BUCKETS ) // can't all be in separate buckets
+      return -1;
+
+   span<uint8_t> buckets( t_searchArena.slab( numGuessesLeft ).guessBuckets.data(), candidateWords.size() );
+   for ( int guess : candidateWords )
+   {
+      g_BucketForGuessTable.gatherRow( guess, candidateWords, buckets.data() );
+      if ( allBucketsDistinct( buckets ) ) // (`guess` itself lands in CORRECT_ANSWER_BUCKET, which no other word can)
+         return guess;
+   }
+   return -1;
+}
+
+// returns `candidateWords` in the order they should be tried as guesses (using `buffer` as storage if they need reordering)
+span<const int> goodOrderForCandidateWords( span<const int> candidateWords, vector<int>& buffer )
+{
+   if ( candidateWords.size() < 50 )
+      return candidateWords;
+
+   int letterFrequency[26] = { 0 }; // but only count letter once in each word
+   for ( int word : candidateWords )
+   {
+      int used = 0;
+      for ( int i = 0; i < WORD_LEN; i++ )
+      {
+         int letter = g_allWords[word][i] - 'a';
+         if ( used & (1<<letter) ) 
+            continue;
+         used |= 1<<letter;
+         letterFrequency[letter]++;
+      }
+   }
+
+   auto scoreForWord = [&letterFrequency]( int word ) { 
+      int score = 0;
+      for ( int i = 0; i < WORD_LEN; i++ )
+         score += letterFrequency[g_allWords[word][i]-'a'];
+      return score;
+   };
+   span<int> ret( buffer.data(), candidateWords.size() );
+   copy( candidateWords.begin(), candidateWords.end(), ret.begin() );
+   sort( ret.begin(), ret.end(), [&]( int a, int b ) { return scoreForWord( a ) > scoreForWord( b ); } );
+   return ret;
+}
+
+// returns one of `guesses` that puts each candidate into a separate bucket, or -1 if there isn't one
+// (scores 2, which is the best possible when `optimalGuess` fails)
+int perfectSplitGuess( span<const int> candidateWords, span<const int> guesses, int numGuessesLeft )
+{
+   if ( candidateWords.size() >= NUM_BUCKETS )
+      return -1;
+
+   span<uint8_t> buckets( t_searchArena.slab( numGuessesLeft ).guessBuckets.data(), candidateWords.size() );
+   for ( int guess : guesses )
+   {
+      g_BucketForGuessTable.gatherRow( guess, candidateWords, buckets.data() );
+      if ( allBucketsDistinct( buckets ) )
+         return guess;
+   }
+   return -1;
+}
+
+// fills in `partition` for `guess` (`words` starts with the candidates, and its signature covers all of `words` -- see `guessesToTry`)
+void calcGuessPartition( span<const int> words, size_t numCandidateWords, int guess, span<uint8_t> buckets, GuessPartition& partition )
+{
+   g_BucketForGuessTable.gatherRow( guess, words, buckets.data() );
+
+   int wordsInBucket[NUM_BUCKETS] = { 0 };
+   BucketSet usedBuckets = bucketHistogram( buckets.first( numCandidateWords ), wordsInBucket );
+   partition.guess = guess;
+   partition.isCandidate = usedBuckets.contains( CORRECT_ANSWER_BUCKET );
+   partition.sumOfSquares = 0;
+   usedBuckets.forEach( [&]( int bucket ) { partition.sumOfSquares += wordsInBucket[bucket] * wordsInBucket[bucket]; } );
+
+   // hash the buckets after relabeling them in order of first appearance, so it only depends on how the words are grouped
+   uint8_t label[NUM_BUCKETS];
+   fill( label, label + NUM_BUCKETS, 0xff );
+   uint8_t numLabels = 0;
+   uint64_t signature = 0xcbf29ce484222325ULL;
+   for ( uint8_t bucket : buckets )
+   {
+      if ( label[bucket] == 0xff )
+         label[bucket] = numLabels++;
+      signature = ( signature ^ label[bucket] ) * 0x100000001b3ULL;
+   }
+   partition.signature = signature;
+}
+
+// true if `guessA` and `guessB` split `words` into exactly the same groups
+bool haveSamePartition( span<const int> words, int guessA, int guessB )
+{
+   uint8_t labelForA[NUM_BUCKETS];
+   uint8_t labelForB[NUM_BUCKETS];
+   fill( labelForA, labelForA + NUM_BUCKETS, 0xff );
+   fill( labelForB, labelForB + NUM_BUCKETS, 0xff );
+   uint8_t numLabels = 0;
+   for ( int word : words )
+   {
+      uint8_t& a = labelForA[g_BucketForGuessTable.bucket( guessA, word )];
+      uint8_t& b = labelForB[g_BucketForGuessTable.bucket( guessB, word )];
+      if ( a == 0xff && b == 0xff )
+         a = b = numLabels++;
+      else if ( a != b )
+         return false;
+   }
+   return true;
+}
+
+// candidate counts from which guesses are ranked by how they split the families (see `familySplitRank`) -- for smaller subproblems
+// it doesn't pay for itself (and they are cut off before most of their guesses are tried anyway)
+constexpr size_t MIN_SIZE_FOR_FAMILY_SPLIT = 300;
+
+// groups the candidates' "families" into `slab.familyWords` and `slab.familyEnds`, and returns how many there are -- a family is three
+// or more words that differ in just one position (e.g. _ight), which no guess can tell apart all at once, so they are what usually
+// sets the worst case
+int groupFamilies( span<const int> candidateWords, SearchArena::Slab& slab )
+{
+   // for each position, sort the words by the other four letters
+   size_t numWords = candidateWords.size();
+   int numFamilyWords = 0;
+   int numFamilies = 0;
+   for ( int position = 0; position < WORD_LEN; position++ )
+   {
+      for ( size_t i = 0; i < numWords; i++ )
+      {
+         const string& word = g_allWords[candidateWords[i]];
+         uint32_t key = 0;
+         for ( int j = 0; j < WORD_LEN; j++ )
+            key = key * 27 + ( j == position ? 26 : word[j] - 'a' );
+         slab.familyKeys[i] = { key, candidateWords[i] };
+      }
+      sort( slab.familyKeys.begin(), slab.familyKeys.begin() + numWords );
+      for ( size_t begin = 0, end; begin < numWords; begin = end )
+      {
+         for ( end = begin + 1; end < numWords && slab.familyKeys[end].first == slab.familyKeys[begin].first; end++ )
+            ;
+         if ( end - begin < 3 )
+            continue;
+         for ( size_t i = begin; i < end; i++ )
+            slab.familyWords[numFamilyWords++] = slab.familyKeys[i].second;
+         slab.familyEnds[numFamilies++] = numFamilyWords;
+      }
+   }
+   return numFamilies;
+}
+
+// how well `guess` breaks up the families found by `groupFamilies` (smaller is better): by the most words of any one family it leaves
+// together, then by the sum of the squared family parts, then by how evenly it splits all the candidates
+// (at 2315, the first opener that reaches a worst case of 5 comes 43rd in this order, but only after ~1350 guesses that each have to be
+// refuted first by the sum of squares alone)
+uint64_t familySplitRank( int guess, span<const int> candidateWords, int numFamilies, SearchArena::Slab& slab )
+{
+   int wordsInBucket[NUM_BUCKETS] = { 0 };
+   span<const int> familyWords( slab.familyWords.data(), numFamilies ? slab.familyEnds[numFamilies-1] : 0 );
+   g_BucketForGuessTable.gatherRow( guess, familyWords, slab.familyBuckets.data() );
+   uint64_t largestPart = 0;
+   uint64_t familySumOfSquares = 0;
+   for ( int family = 0, begin = 0; family < numFamilies; begin = slab.familyEnds[family++] )
+   {
+      int end = slab.familyEnds[family];
+      int largestPartOfFamily = 0;
+      for ( int j = begin; j < end; j++ )
+         largestPartOfFamily = max( largestPartOfFamily, ++wordsInBucket[slab.familyBuckets[j]] );
+      for ( int j = begin; j < end; j++ )
+         wordsInBucket[slab.familyBuckets[j]] = 0;
+      largestPart = max<uint64_t>( largestPart, largestPartOfFamily );
+      familySumOfSquares += largestPartOfFamily * largestPartOfFamily;
+   }
+
+   span<uint8_t> buckets( slab.guessBuckets.data(), candidateWords.size() );
+   g_BucketForGuessTable.gatherRow( guess, candidateWords, buckets.data() );
+   for ( uint8_t bucket : buckets )
+      wordsInBucket[bucket]++;
+   uint64_t sumOfSquares = 0;
+   for ( uint8_t bucket : buckets )
+      sumOfSquares += wordsInBucket[bucket];
+
+   // (sums of squares of up to 2315 words take 23 bits, and those of the family parts, 27 more)
+   return largestPart << 50 | familySumOfSquares << 23 | sumOfSquares;
+}
+
+// returns `candidateWords` sorted by `familySplitRank`, for objectives where finding a guess that works at all matters more than
+// finding the best one first (see `CANDIDATES_BY_FAMILY_SPLIT`)
+span<const int> candidateWordsByFamilySplit( span<const int> candidateWords, int numFamilies, SearchArena::Slab& slab )
+{
+   size_t numWords = candidateWords.size();
+   for ( size_t i = 0; i < numWords; i++ )
+      slab.guessRanks[i] = { familySplitRank( candidateWords[i], candidateWords, numFamilies, slab ), candidateWords[i] };
+   sort( slab.guessRanks.begin(), slab.guessRanks.begin() + numWords );
+
+   span<int> ret( slab.guessOrder.data(), numWords );
+   for ( size_t i = 0; i < numWords; i++ )
+      ret[i] = slab.guessRanks[i].second;
+   return ret;
+}
+
+// the guesses `calcScore` should try, best first: the candidate words (by family split if `candidatesByFamilySplit`), then (if `g_guessFromAllWords`) those of `otherGuesses` that are worth trying
+// a non-candidate is dropped if it doesn't split the candidates at all, or splits them exactly like an earlier guess does
+// (a candidate beats a non-candidate with the same split, since it might also be the answer);
+// the rest are ranked by how evenly they split the candidates (or like the candidates, if they are by family split)
+// in hard mode, a guess also decides which of the other words may follow it in each bucket, so two guesses are only
+// interchangeable if they split those words the same way too -- `words` is what `calcScore` got (the candidates first)
+span<const int> guessesToTry( span<const int> words, size_t numCandidateWords, span<const int> otherGuesses, int numGuessesLeft, bool candidatesByFamilySplit )
+{
+   span<const int> candidateWords = words.first( numCandidateWords );
+   SearchArena::Slab& slab = t_searchArena.slab( numGuessesLeft );
+   bool byFamilySplit = candidatesByFamilySplit && candidateWords.size() >= MIN_SIZE_FOR_FAMILY_SPLIT;
+   int numFamilies = byFamilySplit ? groupFamilies( candidateWords, slab ) : 0;
+   span<const int> candidateGuesses = byFamilySplit ? candidateWordsByFamilySplit( candidateWords, numFamilies, slab )
+      : candidatesByFamilySplit ? candidateWords : goodOrderForCandidateWords( candidateWords, slab.guessOrder );
+   if ( !g_guessFromAllWords )
+      return candidateGuesses;
+
+   vector<int>& guessOrder = slab.guessOrder;
+   if ( candidateGuesses.data() != guessOrder.data() )
+      copy( candidateGuesses.begin(), candidateGuesses.end(), guessOrder.begin() );
+
+   span<uint8_t> buckets( slab.guessBuckets.data(), words.size() );
+   vector<GuessPartition>& partitions = slab.guessPartitions;
+   int numPartitions = 0;
+   for ( int guess : otherGuesses )
+   {
+      GuessPartition& partition = partitions[numPartitions];
+      calcGuessPartition( words, numCandidateWords, guess, buckets, partition );
+      if ( !partition.isCandidate && partition.sumOfSquares == (int) ( candidateWords.size() * candidateWords.size() ) )
+         continue; // everything in one bucket -- learns nothing
+      numPartitions++;
+   }
+
+   // drop duplicate splits, keeping candidates first, then the lowest word index
+   auto bySignature = []( const GuessPartition& a, const GuessPartition& b ) {
+      return tie( a.signature, b.isCandidate, a.guess ) < tie( b.signature, a.isCandidate, b.guess );
+   };
+   sort( partitions.begin(), partitions.begin() + numPartitions, bySignature );
+   for ( int i = 0; i < numPartitions; i++ )
+   {
+      GuessPartition& partition = partitions[i];
+      partition.isDuplicate = false;
+      for ( int j = i-1; j >= 0 && partitions[j].signature == partition.signature && !partition.isDuplicate; j-- )
+         partition.isDuplicate = haveSamePartition( words, partitions[j].guess, partition.guess );
+   }
+   int numNonCandidates = 0;
+   for ( int i = 0; i < numPartitions; i++ )
+      if ( !partitions[i].isCandidate && !partitions[i].isDuplicate )
+         partitions[numNonCandidates++] = partitions[i];
+
+   if ( byFamilySplit )
+   {
+      for ( int i = 0; i < numNonCandidates; i++ )
+         slab.guessRanks[i] = { familySplitRank( partitions[i].guess, candidateWords, numFamilies, slab ), partitions[i].guess };
+      sort( slab.guessRanks.begin(), slab.guessRanks.begin() + numNonCandidates );
+      for ( int i = 0; i < numNonCandidates; i++ )
+         guessOrder[candidateGuesses.size() + i] = slab.guessRanks[i].second;
+      return span<const int>( guessOrder.data(), candidateGuesses.size() + numNonCandidates );
+   }
+   sort( partitions.begin(), partitions.begin() + numNonCandidates, []( const GuessPartition& a, const GuessPartition& b ) {
+      return tie( a.sumOfSquares, a.guess ) < tie( b.sumOfSquares, b.guess );
+   } );
+   for ( int i = 0; i < numNonCandidates; i++ )
+      guessOrder[candidateGuesses.size() + i] = partitions[i].guess;
+   return span<const int>( guessOrder.data(), candidateGuesses.size() + numNonCandidates );
+}
+
+// the search is compiled once per set of rules and number of guesses left (see `calcScoreForEachDepth`), so each depth's base
+// cases and recursion, and the objective's bounds, are resolved at compile time
+// in hard mode, `words` is the candidates followed by the other words still consistent with the feedback (see `SearchRules`)
+template<typename Rules, int NumGuessesLeft>
+double calcScore( span<const int> words, int& bestGuess, double cutoffScore );
+
+// returns the score for `guess`, or a lower bound that has reached `cutoffScore()` (i.e. it can't beat the current best guess)
+// (the first `numCandidateWords` of `words` are the candidates)
+template<typename Rules, int NumGuessesLeft, typename CutoffScore>
+double calcScoreForGuess( span<const int> words, size_t numCandidateWords, int guess, const CutoffScore& cutoffScore )
+{
+   SearchArena::Slab& slab = t_searchArena.slab( NumGuessesLeft );
+   span<uint8_t> buckets( slab.guessBuckets.data(), words.size() );
+   g_BucketForGuessTable.gatherRow( guess, words, buckets.data() );
+   SEARCH_STATS_COUNT( GuessesScored, NumGuessesLeft );
+
+   // (only the buckets in `usedBuckets` are visited from here on -- a guess typically uses a few dozen of the NUM_BUCKETS, and
+   // for the many small subproblems, scanning all of them cost more than the candidates themselves)
+   int wordsInBucket[NUM_BUCKETS] = { 0 };
+   BucketSet usedBuckets = bucketHistogram( buckets.first( numCandidateWords ), wordsInBucket );
+   wordsInBucket[CORRECT_ANSWER_BUCKET] = 0; // `guess` itself
+   usedBuckets.erase( CORRECT_ANSWER_BUCKET );
+
+   double lowerBoundScore = Rules::lowerBoundScoreForGuess( wordsInBucket, usedBuckets, numCandidateWords, NumGuessesLeft-1 );
+   if ( lowerBoundScore >= cutoffScore() )
+   {
+      SEARCH_STATS_COUNT( GuessesPrunedByBound, NumGuessesLeft );
+      return lowerBoundScore;
+   }
+
+   // in hard mode, the other words consistent with a bucket's feedback go into its subproblem too (after its candidates,
+   // since they come after them in `words`) -- words in a bucket without candidates are dropped, as no answer leads there
+   const int* wordsInPartition = wordsInBucket;
+   int wordsInBucketWithOthers[NUM_BUCKETS];
+   if constexpr ( Rules::HARD_MODE )
+   {
+      copy( wordsInBucket, wordsInBucket + NUM_BUCKETS, wordsInBucketWithOthers );
+      for ( size_t i = numCandidateWords; i < words.size(); i++ )
+         wordsInBucketWithOthers[buckets[i]]++;
+      wordsInPartition = wordsInBucketWithOthers;
+   }
+
+   // partition the words by bucket (counting sort), so each bucket is a contiguous range of `partitionedWords`
+   int bucketStart[NUM_BUCKETS];
+   int bucketEnd[NUM_BUCKETS];
+   int bucketOrder[NUM_BUCKETS];
+   int numBucketsUsed = 0;
+   int start = 0;
+   usedBuckets.forEach( [&]( int bucket ) {
+      bucketStart[bucket] = bucketEnd[bucket] = start;
+      start += wordsInPartition[bucket];
+      bucketOrder[numBucketsUsed++] = bucket;
+   } );
+   vector<int>& partitionedWords = slab.partitionedWords;
+   if constexpr ( Rules::HARD_MODE )
+   {
+      for ( size_t i = 0; i < words.size(); i++ ) if ( usedBuckets.contains( buckets[i] ) )
+         partitionedWords[bucketEnd[buckets[i]]++] = words[i];
+   }
+   else
+   {
+      for ( size_t i = 0; i < words.size(); i++ ) if ( buckets[i] != CORRECT_ANSWER_BUCKET )
+         partitionedWords[bucketEnd[buckets[i]]++] = words[i];
+   }
+
+   // (ties in bucket order -- the same order as a `stable_sort`, without its temporary buffer)
+   sort( bucketOrder, bucketOrder + numBucketsUsed, [&]( int a, int b ) { 
+      return Rules::LARGEST_BUCKETS_FIRST ? tie( wordsInBucket[b], a ) < tie( wordsInBucket[a], b ) : tie( wordsInBucket[a], a ) < tie( wordsInBucket[b], b ); 
+   } );
+   if constexpr ( Rules::LARGEST_BUCKETS_FIRST )
+   {
+      for ( size_t i = 0; i < numCandidateWords; i++ ) if ( words[i] == t_killerWord[NumGuessesLeft] )
+      {
+         int* killerBucket = find( bucketOrder, bucketOrder + numBucketsUsed, (int) buckets[i] );
+         if ( killerBucket != bucketOrder + numBucketsUsed )
+            rotate( bucketOrder, killerBucket, killerBucket + 1 );
+         break;
+      }
+   }
+
+   double scoreForBucket[NUM_BUCKETS];
+   for ( int i = 0; i < numBucketsUsed; i++ )
+   {
+      int bucket = bucketOrder[i];
+      span<const int> remainingWords( &partitionedWords[bucketStart[bucket]], wordsInPartition[bucket] );
+      size_t bucketSize = wordsInBucket[bucket];
+      double minScoreForBucket = Rules::minScore( bucketSize, NumGuessesLeft-1 );
+      double cutoffScoreForBucket = Rules::cutoffScoreForBucket( cutoffScore(), lowerBoundScore, minScoreForBucket, bucketSize, numCandidateWords );
+      int localBestGuess = remainingWords[0];
+      scoreForBucket[bucket] = calcScore<Rules, NumGuessesLeft-1>( remainingWords, localBestGuess, cutoffScoreForBucket );
+      lowerBoundScore = Rules::addScoreForBucket( lowerBoundScore, scoreForBucket[bucket], minScoreForBucket, bucketSize, numCandidateWords );
+      if ( scoreForBucket[bucket] >= cutoffScoreForBucket || lowerBoundScore >= cutoffScore() )
+      {
+         if constexpr ( Rules::LARGEST_BUCKETS_FIRST )
+            t_killerWord[NumGuessesLeft] = remainingWords[0];
+         SEARCH_STATS_COUNT( GuessesCutOff, NumGuessesLeft );
+         return max( lowerBoundScore, cutoffScore() );
+      }
+   }
+
+   return Rules::scoreForGuess( scoreForBucket, wordsInBucket, usedBuckets, numCandidateWords, lowerBoundScore );
+}
+
+// best guess found so far by the `parallelFor` workers in `calcScoreInParallel`
+// ties are broken by the guess order, so the result matches the single-threaded search exactly
+// `cutoffScore` is called from every bucket of every guess, so it doesn't lock: the best score and its guess are published as atomics
+// (the guess first, then the score), and a cutoff read between two updates is only ever looser than the current one, never tighter
+// -- `update`, called once per guess, takes the mutex to keep the (score, guess order) comparison and the two stores together
+class SharedBestGuess
+{
+public:
+   // a score below `unbeatableScore` stops the search (see the `break` in `calcScore`)
+   SharedBestGuess( double cutoffScore, double unbeatableScore ) : _cutoffScore( cutoffScore ), _unbeatableScore( unbeatableScore ), _score( cutoffScore ) {}
+
+   // the guess at `guessOrderIndex` can be skipped once its lower bound reaches this
+   double cutoffScore( int guessOrderIndex ) const
+   {
+      double score = _score.load( memory_order_acquire );
+      if ( guessOrderIndex > _guessOrderIndex.load( memory_order_relaxed ) ) // a later guess must be strictly better
+         return score < _unbeatableScore ? -INF : score;
+      // an earlier guess wins ties
+      return nextafter( max( score, _unbeatableScore ), INF );
+   }
+   void update( double score, int guessOrderIndex )
+   {
+      lock_guard<mutex> lock( _mutex );
+      if ( score >= _cutoffScore )
+      {
+         _minLowerBoundScore = min( _minLowerBoundScore, score );
+         return;
+      }
+      double bestScore = _score.load( memory_order_relaxed );
+      int bestGuessOrderIndex = _guessOrderIndex.load( memory_order_relaxed );
+      bool isBetter = bestGuessOrderIndex == INT_MAX || ( score < _unbeatableScore
+         ? bestScore >= _unbeatableScore || guessOrderIndex < bestGuessOrderIndex
+         : score < bestScore || ( score == bestScore && guessOrderIndex < bestGuessOrderIndex ) );
+      if ( !isBetter )
+         return;
+      _guessOrderIndex.store( guessOrderIndex, memory_order_relaxed );
+      _score.store( score, memory_order_release );
+   }
+   double score() const { return _score.load(); }
+   int guessOrderIndex() const { return _guessOrderIndex.load(); }
+   // if no guess beat the cutoff, the lowest of their lower bounds is one for the whole subproblem
+   double minLowerBoundScore() const { return _minLowerBoundScore; }
+
+private:
+   mutex _mutex;
+   const double _cutoffScore;
+   const double _unbeatableScore;
+   atomic<double> _score;
+   atomic<int> _guessOrderIndex = INT_MAX;
+   double _minLowerBoundScore = INF;
+};
+
+// scores the guesses on all threads, sharing the best score so far so every thread prunes against it
+// returns a lower bound >= `cutoffScore` (and leaves `bestGuess` alone) if no guess beats it
+template<typename Rules, int NumGuessesLeft>
+double calcScoreInParallel( span<const int> words, size_t numCandidateWords, span<const int> guesses, int& bestGuess, double cutoffScore, double unbeatableScore )
+{
+   SharedBestGuess sharedBest( cutoffScore, unbeatableScore );
+   parallelFor( (int) guesses.size(), [&]( int guessOrderIndex )
+   {
+      if ( sharedBest.cutoffScore( guessOrderIndex ) <= -INF )
+         return;
+      double score = calcScoreForGuess<Rules, NumGuessesLeft>( words, numCandidateWords, guesses[guessOrderIndex], [&]() { 
+         return sharedBest.cutoffScore( guessOrderIndex ); 
+      } );
+      sharedBest.update( score, guessOrderIndex );
+   } );
+
+   if ( sharedBest.guessOrderIndex() == INT_MAX )
+      return sharedBest.minLowerBoundScore();
+   if ( sharedBest.score() < unbeatableScore && sharedBest.guessOrderIndex() + 1 < (int) guesses.size() )
+      SEARCH_STATS_COUNT( EarlyBreaks, NumGuessesLeft );
+   bestGuess = guesses[sharedBest.guessOrderIndex()];
+   return sharedBest.score();
+}
+
+template<typename Rules, int NumGuessesLeft>
+double calcScore( span<const int> words, int& bestGuess, double cutoffScore )
+{
+   span<const int> candidateWords = words;
+   span<const int> otherGuesses = g_allGuesses;
+   if constexpr ( Rules::HARD_MODE )
+   {
+      size_t numCandidateWords = partition_point( words.begin(), words.end(), []( int word ) { return word < g_numAnswers; } ) - words.begin();
+      candidateWords = words.first( numCandidateWords );
+      otherGuesses = words.subspan( numCandidateWords );
+   }
+
+   SEARCH_STATS_COUNT( CalcScoreCalls, NumGuessesLeft );
+   SEARCH_STATS_COUNT_CANDIDATES( candidateWords.size(), NumGuessesLeft );
+
+   if ( candidateWords.size() == 1 )
+      return 1;
+   if constexpr ( NumGuessesLeft <= 1 )
+      return INF;
+   if ( candidateWords.size() == 2 )
+      return Rules::scoreForTwoCandidates();
+
+   TranspositionCache::Key cacheKey = TranspositionCache::keyFor( words, NumGuessesLeft, Rules::ID );
+   {
+      double cachedScore;
+      if ( g_transpositionCache.lookup( cacheKey, cutoffScore, cachedScore, bestGuess ) )
+      {
+         SEARCH_STATS_COUNT( CacheHits, NumGuessesLeft );
+         return cachedScore;
+      }
+   }
+
+   double bestScore = cutoffScore;
+
+   // optimization -- quickly check for an optimal guess (i.e. a guess that puts each candidate into a separate bucket)
+   bestGuess = optimalGuess( candidateWords, NumGuessesLeft );
+   double lowerBoundScore = Rules::minScoreWithoutOptimalGuess( candidateWords.size(), NumGuessesLeft );
+   if ( bestGuess >= 0 )
+   {
+      SEARCH_STATS_COUNT( OptimalGuessHits, NumGuessesLeft );
+      bestScore = Rules::scoreForOptimalGuess( candidateWords.size() );
+   }
+   else if ( lowerBoundScore >= cutoffScore ) // (most nodes of a worst case search, which only asks whether the candidates can be found in one guess fewer)
+   {
+      bestScore = lowerBoundScore;
+   }
+   else if constexpr ( NumGuessesLeft <= 2 ) // if optimal guess doesn't exist, we need at least 3 guesses (or a non-candidate that splits them all up)
+   {
+      bestGuess = g_guessFromAllWords ? perfectSplitGuess( candidateWords, otherGuesses, NumGuessesLeft ) : -1;
+      bestScore = bestGuess >= 0 ? 2 : INF;
+   }
+   else if ( Rules::onlyPerfectSplitCanBeat( cutoffScore ) )
+   {
+      bestGuess = perfectSplitGuess( candidateWords, otherGuesses, NumGuessesLeft );
+      bestScore = bestGuess >= 0 ? 2 : 3;
+   }
+   else
+   {
+      SEARCH_STATS_COUNT( NodesExpanded, NumGuessesLeft );
+      SEARCH_STATS_TIME( NumGuessesLeft );
+      span<const int> candidateWordsInGoodGuessOrder = guessesToTry( words, candidateWords.size(), otherGuesses, NumGuessesLeft, Rules::CANDIDATES_BY_FAMILY_SPLIT );
+      double unbeatableScore = Rules::unbeatableScore( candidateWords.size(), NumGuessesLeft );
+
+      if ( g_numThreads > 1 && !isInParallelFor() && (int) candidateWords.size() >= MIN_CANDIDATES_FOR_PARALLEL_SEARCH )
+      {
+         bestScore = calcScoreInParallel<Rules, NumGuessesLeft>( words, candidateWords.size(), candidateWordsInGoodGuessOrder, bestGuess, cutoffScore, unbeatableScore );
+      }
+      else
+      {
+         // score each guess, and keep track which is best
+         double minLowerBoundScore = INF;
+         for ( int guess : candidateWordsInGoodGuessOrder )
+         {
+            double score = calcScoreForGuess<Rules, NumGuessesLeft>( words, candidateWords.size(), guess, [&]() { return bestScore; } );
+            minLowerBoundScore = min( minLowerBoundScore, score );
+
+            if ( score < bestScore )
+            {
+               bestScore = score;
+               bestGuess = guess;
+               if ( bestScore < unbeatableScore )
+               {
+                  SEARCH_STATS_COUNT( EarlyBreaks, NumGuessesLeft );
+                  break; // nothing can be better, since we checked for optimal already
+               }
+            }
+         }
+         if ( bestGuess < 0 )
+            bestScore = minLowerBoundScore;
+      }
+   }
+
+   if ( bestGuess >= 0 )
+   {
+      g_transpositionCache.storeExact( cacheKey, (int) candidateWords.size(), bestScore, bestGuess );
+   }
+   else
+   {
+      bestScore = Rules::tightenLowerBound( bestScore );
+      g_transpositionCache.storeLowerBound( cacheKey, (int) candidateWords.size(), bestScore );
+   }
+
+   return bestScore;
+}
+
+// calls `fn( Rules() )` with the search rules for the current objective and mode
+template<typename Fn>
+auto withSearchRules( Fn fn )
+{
+   bool isHardMode = isHardModeSearch();
+   if ( g_objective == Objective::WorstCase )
+      return isHardMode ? fn( SearchRules<WorstCase, true>() ) : fn( SearchRules<WorstCase, false>() );
+   return isHardMode ? fn( SearchRules<ExpectedGuesses, true>() ) : fn( SearchRules<ExpectedGuesses, false>() );
+}
+
+using CalcScoreFn = double (*)( span<const int>, int&, double );
+
+// `calcScore<Rules, 1>`, ..., `calcScore<Rules, MAX_NUM_GUESSES>`, indexed by the number of guesses left minus 1
+template<typename Rules, size_t... Depths>
+constexpr array<CalcScoreFn, sizeof...( Depths )> calcScoreForEachDepth( index_sequence<Depths...> )
+{
+   return { &calcScore<Rules, (int) Depths + 1>... };
+}
+
+template<typename Rules>
+CalcScoreFn calcScoreForDepth( int numGuessesLeft )
+{
+   static constexpr auto forDepth = calcScoreForEachDepth<Rules>( make_index_sequence<MAX_NUM_GUESSES>() );
+   return forDepth[numGuessesLeft-1];
+}
+
+// runs `search( cutoffScore )` -- for worst case scores, which are whole numbers of guesses, as a series of yes/no questions instead:
+// can every answer be found in 1 guess? in 2? ... -- a cutoff of k + 0.5 refutes a guess as soon as one bucket needs more than k,
+// whereas searching with the caller's cutoff (often INF) solves every bucket of the first guesses exactly, however hopeless they are
+// (returns INF if not even `numGuessesLeft` guesses are enough)
+template<typename Rules, typename SearchFn>
+double searchByDeepening( int numGuessesLeft, double cutoffScore, SearchFn search )
+{
+   if constexpr ( is_base_of_v<WorstCase, Rules> )
+   {
+      int k = 1;
+      for ( ; k <= numGuessesLeft && k + 0.5 < cutoffScore; k++ )
+      {
+         double score = search( k + 0.5 );
+         if ( score < k + 0.5 )
+            return score;
+      }
+      if ( k > numGuessesLeft )
+         return INF;
+   }
+   return search( cutoffScore );
+}
+
+double calcScore( span<const int> candidateWords, int& bestGuess, int numGuessesLeft, double cutoffScore )
+{
+   if ( numGuessesLeft <= 0 )
+      return INF;
+   g_transpositionCache.allocate();
+   return withSearchRules( [&]( auto rules ) {
+      using Rules = decltype( rules );
+      CalcScoreFn fn = calcScoreForDepth<Rules>( numGuessesLeft );
+      double score = searchByDeepening<Rules>( numGuessesLeft, cutoffScore, [&]( double cutoff ) {
+         return fn( candidateWords, bestGuess, cutoff );
+      } );
+      if ( score == INF )
+         bestGuess = -1;
+      return score;
+   } );
+}
+
+struct FixedCutoffScore
+{
+   double score;
+   double operator()() const { return score; }
+};
+
+using CalcScoreForGuessFn = double (*)( span<const int>, size_t, int, const FixedCutoffScore& );
+
+// `calcScoreForGuess<Rules, 2>`, ..., `calcScoreForGuess<Rules, MAX_NUM_GUESSES>`, indexed by the number of guesses left minus 2
+template<typename Rules, size_t... Depths>
+constexpr array<CalcScoreForGuessFn, sizeof...( Depths )> calcScoreForGuessForEachDepth( index_sequence<Depths...> )
+{
+   return { &calcScoreForGuess<Rules, (int) Depths + 2, FixedCutoffScore>... };
+}
+
+template<typename Rules>
+CalcScoreForGuessFn calcScoreForGuessForDepth( int numGuessesLeft )
+{
+   static constexpr auto forDepth = calcScoreForGuessForEachDepth<Rules>( make_index_sequence<MAX_NUM_GUESSES-1>() );
+   return forDepth[numGuessesLeft-2];
+}
+
+double calcScoreForGuess( span<const int> candidateWords, int guess, int numGuessesLeft, double cutoffScore )
+{
+   size_t numCandidateWords = partition_point( candidateWords.begin(), candidateWords.end(), []( int word ) { return word < g_numAnswers; } ) - candidateWords.begin();
+   if ( numGuessesLeft <= 1 ) // (the search itself never scores a guess that can't be followed by another)
+      return numCandidateWords == 1 && candidateWords[0] == guess ? 1 : INF;
+   g_transpositionCache.allocate();
+   return withSearchRules( [&]( auto rules ) {
+      using Rules = decltype( rules );
+      CalcScoreForGuessFn fn = calcScoreForGuessForDepth<Rules>( numGuessesLeft );
+      return searchByDeepening<Rules>( numGuessesLeft, cutoffScore, [&]( double cutoff ) {
+         return fn( candidateWords, numCandidateWords, guess, FixedCutoffScore{ cutoff } );
+      } );
+   } );
+}
+
+// precomputes what the search needs for the current dictionary
+void prepareSearch()
+{
+   calcMinScores();
+   g_allGuesses.resize( g_allWords.size() );
+   for ( int i = 0; i < (int) g_allWords.size(); i++ )
+      g_allGuesses[i] = i;
+}
+
+void setDictionary( int numAnswers )
+{
+   g_allWords = g_guessFromAllWords ? WordleDictionary::getGuesses( numAnswers ) : WordleDictionary::getWords( numAnswers );
+   g_numAnswers = numAnswers;
+   g_BucketForGuessTable = BucketForGuessTable( g_allWords, numTableColumns() );
+   g_transpositionCache.clear();
+   prepareSearch();
+}
+
+void growDictionary( int numAnswers )
+{
+   g_allWords = g_guessFromAllWords ? WordleDictionary::getGuesses( numAnswers ) : WordleDictionary::getWords( numAnswers );
+   g_numAnswers = numAnswers;
+   g_BucketForGuessTable.grow( g_allWords, numTableColumns() );
+   // (in hard mode the new answer was already one of the other allowed words, so every cached subproblem that has it is now wrong)
+   if ( isHardModeSearch() )
+      g_transpositionCache.clear();
+   prepareSearch();
+}
+
+void setDictionary( const vector<string>& words, const BucketForGuessTable& table )
+{
+   g_allWords = words;
+   g_numAnswers = table.numAnswers();
+   g_guessFromAllWords = table.numGuesses() > table.numAnswers();
+   if ( isHardModeSearch() )
+      throw "in `setDictionary`: hard mode needs a table with a column for every word, which solution files don't have";
+   g_BucketForGuessTable = BucketForGuessTable::view( table.row( 0 ), table.numGuesses(), table.numAnswers(), table.stride() );
+   g_transpositionCache.clear();
+   prepareSearch();
+}
+
+vector<int> allAnswers()
+{
+   vector<int> words;
+   for ( int i = 0; i < g_numAnswers; i++ )
+      words.push_back( i );
+   return words;
+}
+
+vector<int> rootWords()
+{
+   vector<int> words = allAnswers();
+   if ( isHardModeSearch() )
+      for ( int i = g_numAnswers; i < (int) g_allWords.size(); i++ )
+         words.push_back( i );
+   return words;
+}
+
+// group the words by their bucket for `guess` (a stable counting sort through `scratch`, so in hard mode each bucket's
+// candidates still come first), and return where each bucket starts
+void groupByBucket( span<int> words, int guess, int wordsInBucket[NUM_BUCKETS], int bucketStart[NUM_BUCKETS], vector<int>& scratch )
+{
+   fill( wordsInBucket, wordsInBucket + NUM_BUCKETS, 0 );
+   for ( int word : words )
+      wordsInBucket[g_BucketForGuessTable.bucket( guess, word )]++;
+   int bucketEnd[NUM_BUCKETS];
+   for ( int bucket = 0, start = 0; bucket < NUM_BUCKETS; start += wordsInBucket[bucket++] )
+      bucketStart[bucket] = bucketEnd[bucket] = start;
+   for ( int word : words )
+      scratch[bucketEnd[g_BucketForGuessTable.bucket( guess, word )]++] = word;
+   copy( scratch.begin(), scratch.begin() + words.size(), words.begin() );
+}
+
+// appends the (sub)tree for `words` (as passed to `calcScore`) to `nodes`/`children`, and returns the index of its root node (and its score)
+// each node is solved once, and `words` is grouped by bucket in place, so each child's subtree is built from a subrange of it without copying
+int buildDecisionTree( span<int> words, int guessesLeft, double& score, vector<DecisionTree::Node>& nodes, vector<DecisionTree::Child>& children, vector<int>& scratch )
+{
+   int guess = words[0];
+   score = calcScore( words, guess, guessesLeft );
+   // (`calcScore` doesn't always clear `guess` when there's no solution, e.g. with no guesses left -- and a score that's INF
+   // for some answers is scaled down by the others, so it's only known to be more than the guesses left)
+   if ( guess == -1 || score > guessesLeft )
+      throw "the answers can't all be found within the guess limit";
+
+   int wordsInBucket[NUM_BUCKETS];
+   int bucketStart[NUM_BUCKETS];
+   groupByBucket( words, guess, wordsInBucket, bucketStart, scratch );
+
+   int node = (int) nodes.size();
+   int firstChild = (int) children.size();
+   // (in hard mode, a bucket that only other words landed in has no answers, so the game can't get there)
+   for ( int bucket = 0; bucket < NUM_BUCKETS; bucket++ )
+      if ( wordsInBucket[bucket] > 0 && words[bucketStart[bucket]] < g_numAnswers )
+         children.push_back( { bucket, -1 } );
+   nodes.push_back( { guess, firstChild, (int) children.size() - firstChild } );
+
+   for ( int child = firstChild; child < firstChild + nodes[node].numChildren; child++ )
+   {
+      int bucket = children[child].bucket;
+      if ( bucket == CORRECT_ANSWER_BUCKET )
+         continue;
+      double childScore;
+      children[child].node = (int) nodes.size();
+      buildDecisionTree( words.subspan( bucketStart[bucket], wordsInBucket[bucket] ), guessesLeft-1, childScore, nodes, children, scratch );
+   }
+   return node;
+}
+
+double scoreWithNewAnswer( const DecisionTree& tree, int numAnswers, int newAnswer )
+{
+   int numGuesses = 1;
+   for ( int node = 0; ; numGuesses++ )
+   {
+      int guess = tree.node( node ).guess;
+      if ( guess == newAnswer )
+         break;
+      node = tree.child( node, g_BucketForGuessTable.bucket( guess, newAnswer ) );
+      if ( node == -2 ) // `newAnswer` is alone in its bucket, so it's guessed next
+      {
+         numGuesses++;
+         break;
+      }
+   }
+   if ( numGuesses > g_numGuesses )
+      return INF;
+   if ( g_objective == Objective::WorstCase )
+      return max<double>( tree.score(), numGuesses );
+   return ( tree.score() * numAnswers + numGuesses ) / ( numAnswers + 1 );
+}
+
+DecisionTree calcDecisionTree()
+{
+   vector<int> words = rootWords();
+   vector<int> scratch( words.size() );
+
+   double score;
+   vector<DecisionTree::Node> nodes;
+   vector<DecisionTree::Child> children;
+   buildDecisionTree( words, g_numGuesses, score, nodes, children, scratch );
+   return DecisionTree( move( nodes ), move( children ), score );
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "BucketForGuessTable.h"
+#include "DecisionTree.h"
+#include "TranspositionCache.h"
+
+#include <span>
+#include <string>
+#include <vector>
+
+constexpr int MAX_NUM_GUESSES = 6; // sizes the per-depth arrays -- `g_numGuesses` can lower the limit at runtime
+constexpr double INF = 1e20;
+
+extern int g_numGuesses; // the guess limit the game is solved for (at most MAX_NUM_GUESSES)
+
+// the dictionary being solved
+extern std::vector<std::string> g_allWords; // every word that can be guessed -- the first `g_numAnswers` of them are the possible answers
+extern int g_numAnswers;
+extern bool g_guessFromAllWords; // if false, only the remaining candidate words are guessed (like hard mode, but without the constraints)
+
+// what `calcScore` minimizes
+enum class Objective
+{
+   ExpectedGuesses, // the average number of guesses over all the answers
+   WorstCase,       // the most guesses any answer takes (among equally good guesses, the first one tried is kept)
+};
+extern Objective g_objective;
+// if true, each guess must be consistent with all the feedback so far -- this only restricts the non-candidate guesses, so it
+// only matters with `g_guessFromAllWords` (and then the table needs a column for every word, not just the answers)
+extern bool g_hardMode;
+extern BucketForGuessTable g_BucketForGuessTable;
+extern TranspositionCache g_transpositionCache;
+
+// uses the first `numAnswers` words as the possible answers (guesses come from `WordleDictionary::getGuesses` if `g_guessFromAllWords`)
+void setDictionary( int numAnswers );
+// like `setDictionary`, but for a dictionary that extends the current one (e.g. the next size of a sweep):
+// only the table's new rows and columns are built, and the transposition cache is kept -- a cached subproblem's
+// candidates don't include the new answers, and the guesses it can use don't change, so its result is still valid
+// (except in hard mode, where the new answer was one of the other words a subproblem could guess -- the cache is cleared then)
+void growDictionary( int numAnswers );
+// uses an already built dictionary (e.g. from a SolutionFile) -- `table` must outlive the search
+void setDictionary( const std::vector<std::string>& words, const BucketForGuessTable& table );
+
+// 0, 1, ..., g_numAnswers-1
+std::vector<int> allAnswers();
+// the words `calcScore` starts from: `allAnswers`, followed in hard mode by all the other words (as they are all still consistent)
+std::vector<int> rootWords();
+
+// a guess among `candidateWords` that puts every other candidate in a bucket of its own (-1 if there is none)
+int optimalGuess( std::span<const int> candidateWords, int numGuessesLeft );
+
+// expected number of guesses to find the answer among `candidateWords`, with `numGuessesLeft` guesses left (INF if that isn't always possible)
+// (or the most guesses it can take, for `Objective::WorstCase`)
+// returns the exact score if it is below `cutoffScore`, otherwise just some lower bound that is >= `cutoffScore`
+// in hard mode, `candidateWords` must be followed by the other words still consistent with the feedback (see `rootWords`)
+double calcScore( std::span<const int> candidateWords, int& bestGuess, int numGuessesLeft, double cutoffScore = INF );
+// the score of guessing `guess` first, and then the best guesses (`candidateWords` as for `calcScore`, and the same cutoff rules)
+double calcScoreForGuess( std::span<const int> candidateWords, int guess, int numGuessesLeft, double cutoffScore = INF );
+
+// solves the whole dictionary
+DecisionTree calcDecisionTree();
+
+// the score of `tree`'s strategy (for the first `numAnswers` answers) once it also has to find `newAnswer` -- the new answer
+// follows the tree until it is guessed or lands in a bucket of its own -- so an upper bound on the bigger dictionary's score
+double scoreWithNewAnswer( const DecisionTree& tree, int numAnswers, int newAnswer );
@@ -0,0 +1,193 @@
+#include "StrategyEvaluation.h"
+#include "ParallelFor.h"
+#include "Solver.h"
+
+#include <algorithm>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+using namespace std;
+
+namespace
+{
+   // `openers` sorted by how evenly they split the answers (the sum of the squares of their bucket sizes), so the likely best
+   // openers are scored first and the cutoff for the rest gets tight early
+   vector<int> inGoodOrder( span<const int> openers )
+   {
+      vector<int> answers = allAnswers();
+      vector<uint8_t> buckets( answers.size() );
+      vector<pair<long long, int>> sumOfSquares;
+      for ( int guess : openers )
+      {
+         g_BucketForGuessTable.gatherRow( guess, answers, buckets.data() );
+         int wordsInBucket[NUM_BUCKETS] = { 0 };
+         for ( uint8_t bucket : buckets )
+            wordsInBucket[bucket]++;
+         long long sum = 0;
+         for ( int n : wordsInBucket )
+            sum += (long long) n * n;
+         sumOfSquares.push_back( { sum, guess } );
+      }
+      sort( sumOfSquares.begin(), sumOfSquares.end() );
+
+      vector<int> ret;
+      for ( const auto& [sum, guess] : sumOfSquares )
+         ret.push_back( guess );
+      return ret;
+   }
+
+   // the exact scores found so far, and the cutoff they give the openers still to be scored
+   class BestExactScores
+   {
+   public:
+      explicit BestExactScores( int numExact ) : _numExact( numExact ) {}
+
+      double cutoffScore()
+      {
+         lock_guard<mutex> lock( _mutex );
+         return _numExact > 0 && (int) _scores.size() == _numExact ? _scores.back() : INF;
+      }
+
+      void add( double score )
+      {
+         lock_guard<mutex> lock( _mutex );
+         _scores.insert( upper_bound( _scores.begin(), _scores.end(), score ), score );
+         if ( _numExact > 0 && (int) _scores.size() > _numExact )
+            _scores.pop_back();
+      }
+
+   private:
+      mutex _mutex;
+      int _numExact;
+      vector<double> _scores; // the best `_numExact`, sorted
+   };
+}
+
+vector<StrategyEvaluation::OpenerScore> StrategyEvaluation::rankOpeners( span<const int> openers, int numExact )
+{
+   vector<int> words = rootWords();
+   vector<int> order = inGoodOrder( openers );
+
+   BestExactScores bestExactScores( numExact );
+   vector<OpenerScore> scores( order.size() );
+   parallelFor( (int) order.size(), [&]( int i )
+   {
+      double cutoffScore = bestExactScores.cutoffScore();
+      double score = calcScoreForGuess( words, order[i], g_numGuesses, cutoffScore );
+      bool isExact = score < cutoffScore;
+      if ( isExact )
+         bestExactScores.add( score );
+      scores[i] = { order[i], score, isExact };
+   } );
+
+   sort( scores.begin(), scores.end(), []( const OpenerScore& a, const OpenerScore& b ) {
+      return tie( a.score, b.isExact, a.guess ) < tie( b.score, a.isExact, b.guess );
+   } );
+   return scores;
+}
+
+StrategyEvaluation::TreeScore StrategyEvaluation::scoreTree( const DecisionTree& tree )
+{
+   if ( tree.empty() )
+      throw "in `StrategyEvaluation::scoreTree`: empty tree";
+
+   TreeScore ret = { 0, vector<int>( g_numGuesses + 1 ), {} };
+   double sumOfNumGuesses = 0;
+   int maxNumGuesses = 0;
+   for ( int answer = 0; answer < g_numAnswers; answer++ )
+   {
+      int numGuesses = 0;
+      for ( int node = 0, n = 1; n <= g_numGuesses && node >= 0; n++ )
+      {
+         int guess = tree.node( node ).guess;
+         node = tree.child( node, g_BucketForGuessTable.bucket( guess, answer ) );
+         if ( node == -1 )
+            numGuesses = n;
+      }
+
+      if ( numGuesses == 0 )
+      {
+         ret.unsolvedAnswers.push_back( answer );
+         continue;
+      }
+      ret.numAnswersForNumGuesses[numGuesses]++;
+      sumOfNumGuesses += numGuesses;
+      maxNumGuesses = max( maxNumGuesses, numGuesses );
+   }
+
+   if ( !ret.unsolvedAnswers.empty() )
+      ret.score = INF;
+   else
+      ret.score = g_objective == Objective::WorstCase ? maxNumGuesses : sumOfNumGuesses / g_numAnswers;
+   return ret;
+}
+
+DecisionTree StrategyEvaluation::readTree( istream& in )
+{
+   unordered_map<string, int> wordIndex;
+   for ( int i = 0; i < (int) g_allWords.size(); i++ )
+      wordIndex[g_allWords[i]] = i;
+
+   // the tree as it's read: each node's children by bucket (-1 = solved)
+   vector<int> guessForNode;
+   vector<map<int, int>> childrenForNode;
+
+   string line;
+   while ( getline( in, line ) )
+   {
+      vector<pair<string, int>> guesses;
+      {
+         istringstream tokens( line );
+         string word, feedback;
+         bool isTreeLine = true;
+         while ( isTreeLine && tokens >> word )
+         {
+            isTreeLine = tokens >> feedback && strToBucket( feedback ) >= 0;
+            guesses.push_back( { word, strToBucket( feedback ) } );
+         }
+         if ( !isTreeLine || guesses.empty() )
+            continue;
+      }
+      if ( guesses.back().second != CORRECT_ANSWER_BUCKET )
+         throw "in `StrategyEvaluation::readTree`: a line doesn't end with a correct guess";
+
+      int node = 0;
+      for ( int i = 0; i < (int) guesses.size(); i++ )
+      {
+         auto it = wordIndex.find( guesses[i].first );
+         if ( it == wordIndex.end() )
+            throw "in `StrategyEvaluation::readTree`: guess isn't in the dictionary";
+         if ( node == (int) guessForNode.size() )
+         {
+            guessForNode.push_back( it->second );
+            childrenForNode.emplace_back();
+         }
+         if ( guessForNode[node] != it->second )
+            throw "in `StrategyEvaluation::readTree`: two lines make different guesses after the same feedback";
+
+         int bucket = guesses[i].second;
+         if ( bucket == CORRECT_ANSWER_BUCKET )
+         {
+            if ( i + 1 < (int) guesses.size() )
+               throw "in `StrategyEvaluation::readTree`: a line goes on after a correct guess";
+            childrenForNode[node][bucket] = -1;
+            break;
+         }
+         node = childrenForNode[node].try_emplace( bucket, (int) guessForNode.size() ).first->second;
+      }
+   }
+
+   vector<DecisionTree::Node> nodes;
+   vector<DecisionTree::Child> children;
+   for ( int node = 0; node < (int) guessForNode.size(); node++ )
+   {
+      nodes.push_back( { guessForNode[node], (int) children.size(), (int) childrenForNode[node].size() } );
+      for ( const auto& [bucket, child] : childrenForNode[node] )
+         children.push_back( { bucket, child } );
+   }
+   double score = nodes.empty() ? INF : scoreTree( DecisionTree::view( nodes, children, 0 ) ).score;
+   return DecisionTree( move( nodes ), move( children ), score );
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "DecisionTree.h"
+
+#include <iosfwd>
+#include <span>
+#include <vector>
+
+// scores given strategies against every answer of the current dictionary (see `setDictionary`), for the current objective
+namespace StrategyEvaluation
+{
+   struct OpenerScore
+   {
+      int guess;
+      double score;
+      bool isExact; // if false, `score` is only a lower bound, which was enough to show the opener isn't among the best
+   };
+
+   // the score of each of `openers` as the first guess (followed by the best guesses), best first
+   // only the best `numExact` openers are guaranteed an exact score (0 = all of them) -- the others are cut off as soon as they
+   // can't make it, which is much faster when ranking every word
+   // the openers are scored on all threads, and share subproblems through the transposition cache
+   std::vector<OpenerScore> rankOpeners( std::span<const int> openers, int numExact );
+
+   struct TreeScore
+   {
+      double score;                             // INF if some answer isn't solved
+      std::vector<int> numAnswersForNumGuesses; // [n] = the number of answers solved in n guesses
+      std::vector<int> unsolvedAnswers;         // not solved within `g_numGuesses` guesses, or not covered by the tree
+   };
+
+   // follows `tree` for every answer
+   TreeScore scoreTree( const DecisionTree& tree );
+
+   // reads a tree in the format `wordle tree` prints: one line per answer, with the guesses and their feedback down to the answer, e.g.
+   //    raise _~___  cloud ___~_  ghoul #####
+   // lines that aren't word/feedback pairs (e.g. the score and timing lines) are skipped
+   // throws if a word isn't in the dictionary, or if two lines disagree on the guess after the same feedback
+   DecisionTree readTree( std::istream& in );
+}
@@ -2,10 +2,10 @@
 
 Timer::Timer()
 {
-   _startTime = std::chrono::system_clock::now();
+   _startTime = std::chrono::steady_clock::now();
 }
 
 double Timer::elapsedTime() const
 {
-   return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::system_clock::now() - _startTime ).count() * 1e-9;
+   return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - _startTime ).count() * 1e-9;
 }
@@ -9,6 +9,6 @@ public:
 	double elapsedTime() const;
 
 protected:
-   std::chrono::time_point<std::chrono::system_clock> _startTime;
+   std::chrono::time_point<std::chrono::steady_clock> _startTime;
 };
 
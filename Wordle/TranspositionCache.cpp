@@ -0,0 +1,151 @@
+#include "TranspositionCache.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace
+{
+   uint64_t mix( uint64_t x ) // splitmix64 finalizer
+   {
+      x ^= x >> 30;
+      x *= 0xbf58476d1ce4e5b9ULL;
+      x ^= x >> 27;
+      x *= 0x94d049bb133111ebULL;
+      x ^= x >> 31;
+      return x;
+   }
+}
+
+TranspositionCache::Key TranspositionCache::keyFor( std::span<const int> candidateWords, int numGuessesLeft, int variant )
+{
+   uint64_t seed = (uint64_t) variant << 32 | (uint32_t) numGuessesLeft;
+   Key key = { mix( seed ), mix( seed + 0x9e3779b97f4a7c15ULL ) };
+   for ( int word : candidateWords )
+   {
+      key.hash = mix( key.hash ^ word );
+      key.check = key.check * 0x100000001b3ULL + word + 1;
+   }
+   key.check = mix( key.check );
+   return key;
+}
+
+bool TranspositionCache::lookup( const Key& key, double cutoffScore, double& score, int& bestGuess )
+{
+   if ( !_entries.empty() )
+   {
+      std::lock_guard<std::mutex> lock( mutexFor( key ) );
+      Entry* slots = slotsFor( key );
+      for ( int i = 0; i < 2; i++ )
+      {
+         const Entry& entry = slots[i];
+         if ( entry.numCandidateWords == 0 || entry.key.hash != key.hash || entry.key.check != key.check )
+            continue;
+         if ( !entry.isLowerBound )
+         {
+            score = entry.score;
+            bestGuess = entry.bestGuess;
+            _hits.fetch_add( 1, std::memory_order_relaxed );
+            return true;
+         }
+         if ( entry.score >= cutoffScore )
+         {
+            score = entry.score;
+            _lowerBoundHits.fetch_add( 1, std::memory_order_relaxed );
+            return true;
+         }
+      }
+   }
+   _misses.fetch_add( 1, std::memory_order_relaxed );
+   return false;
+}
+
+void TranspositionCache::storeExact( const Key& key, int numCandidateWords, double score, int bestGuess )
+{
+   store( key, numCandidateWords, score, bestGuess, false );
+}
+
+void TranspositionCache::storeLowerBound( const Key& key, int numCandidateWords, double lowerBoundScore )
+{
+   store( key, numCandidateWords, lowerBoundScore, -1, true );
+}
+
+void TranspositionCache::store( const Key& key, int numCandidateWords, double score, int bestGuess, bool isLowerBound )
+{
+   if ( _entries.empty() )
+      return;
+
+   Entry newEntry = { key, score, bestGuess, (uint16_t) std::min( numCandidateWords, 0xffff ), isLowerBound };
+
+   std::lock_guard<std::mutex> lock( mutexFor( key ) );
+   _stores.fetch_add( 1, std::memory_order_relaxed );
+   Entry* slots = slotsFor( key );
+
+   // same subproblem already stored -- keep whichever is more useful
+   for ( int i = 0; i < 2; i++ )
+   {
+      Entry& entry = slots[i];
+      if ( entry.numCandidateWords == 0 || entry.key.hash != key.hash || entry.key.check != key.check )
+         continue;
+      if ( !entry.isLowerBound || ( isLowerBound && entry.score >= score ) )
+         return;
+      entry = newEntry;
+      return;
+   }
+
+   if ( slots[0].numCandidateWords == 0 )
+   {
+      slots[0] = newEntry;
+      return;
+   }
+   if ( slots[1].numCandidateWords > 0 )
+      _evictions.fetch_add( 1, std::memory_order_relaxed );
+   if ( newEntry.numCandidateWords >= slots[0].numCandidateWords )
+   {
+      slots[1] = slots[0]; // demote the previous "bigger" entry rather than losing it
+      slots[0] = newEntry;
+   }
+   else
+   {
+      slots[1] = newEntry;
+   }
+}
+
+void TranspositionCache::clear()
+{
+   // (no locks -- no search is running, see the header)
+   std::fill( _entries.begin(), _entries.end(), Entry{} );
+}
+
+void TranspositionCache::allocate()
+{
+   if ( _isAllocated.load( std::memory_order_acquire ) )
+      return;
+   std::lock_guard<std::mutex> lock( _allocationMutex );
+   if ( _isAllocated.load( std::memory_order_relaxed ) )
+      return;
+
+   uint64_t numSlotPairs = uint64_t( std::max( _megabytes, 0 ) ) * 1024 * 1024 / ( 2 * sizeof( Entry ) );
+   numSlotPairs = numSlotPairs ? std::bit_floor( numSlotPairs ) : 0;
+   _entries.assign( numSlotPairs * 2, Entry{} );
+   _indexMask = numSlotPairs ? numSlotPairs - 1 : 0;
+   _isAllocated.store( true, std::memory_order_release );
+}
+
+void TranspositionCache::resize( int megabytes )
+{
+   std::lock_guard<std::mutex> lock( _allocationMutex );
+   _megabytes = megabytes;
+   std::vector<Entry>().swap( _entries );
+   _indexMask = 0;
+   _isAllocated.store( false, std::memory_order_release );
+}
+
+TranspositionCache::Stats TranspositionCache::stats() const
+{
+   return { _hits, _lowerBoundHits, _misses, _stores, _evictions };
+}
+
+void TranspositionCache::resetStats()
+{
+   _hits = _lowerBoundHits = _misses = _stores = _evictions = 0;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+// memo table for `calcScore` subproblems, keyed by the (sorted) candidate words and the number of guesses left
+// each entry holds either the exact score (and best guess), or a lower bound left behind by a search that was cut off
+// the table has a fixed memory budget; when two subproblems compete for a slot, the one with more candidate words is kept
+// the table is only allocated by the first search (see `allocate`), so commands that never search don't pay for it
+class TranspositionCache
+{
+public:
+   struct Key
+   {
+      uint64_t hash;
+      uint64_t check; // second, independent hash to guard against collisions
+   };
+
+   struct Stats
+   {
+      uint64_t hits;
+      uint64_t lowerBoundHits;
+      uint64_t misses;
+      uint64_t stores;
+      uint64_t evictions;
+   };
+
+   explicit TranspositionCache( int megabytes ) : _megabytes( megabytes ) {}
+
+   // `variant` keeps apart the scores of different searches (e.g. for different objectives) on the same words
+   static Key keyFor( std::span<const int> candidateWords, int numGuessesLeft, int variant = 0 );
+
+   // returns true if `key` has an exact score, or a lower bound of at least `cutoffScore`
+   // (`bestGuess` is only set for exact scores)
+   bool lookup( const Key& key, double cutoffScore, double& score, int& bestGuess );
+   void storeExact( const Key& key, int numCandidateWords, double score, int bestGuess );
+   void storeLowerBound( const Key& key, int numCandidateWords, double lowerBoundScore );
+
+   // allocates the table for the memory budget, if it isn't already -- until then, lookups miss and stores are dropped
+   // (every search calls it on entry -- it's thread-safe, and just a flag check once the table is there)
+   void allocate();
+   // drops all entries (the table itself is kept), e.g. when the dictionary changes
+   // must not be called while a search is running -- the searches' lookups and stores aren't locked out
+   void clear();
+   // changes the memory budget, dropping all entries (the table is allocated again by the next `allocate`)
+   // (like `clear`, not while a search is running)
+   void resize( int megabytes );
+
+   Stats stats() const;
+   void resetStats();
+
+private:
+   struct Entry
+   {
+      Key key;
+      double score;
+      int bestGuess;
+      uint16_t numCandidateWords; // 0 = empty
+      uint8_t isLowerBound;
+   };
+
+   void store( const Key& key, int numCandidateWords, double score, int bestGuess, bool isLowerBound );
+   // the two slots `key` may occupy: [0] keeps the bigger subproblem, [1] always takes the newest one
+   Entry* slotsFor( const Key& key ) { return &_entries[( key.hash & _indexMask ) * 2]; }
+   std::mutex& mutexFor( const Key& key ) { return _mutexes[key.hash % NUM_MUTEXES]; }
+
+   static constexpr int NUM_MUTEXES = 1024;
+
+   int _megabytes;
+   std::atomic<bool> _isAllocated = false;
+   std::mutex _allocationMutex;
+   std::vector<Entry> _entries;
+   uint64_t _indexMask = 0;
+   std::mutex _mutexes[NUM_MUTEXES];
+
+   std::atomic<uint64_t> _hits = 0;
+   std::atomic<uint64_t> _lowerBoundHits = 0;
+   std::atomic<uint64_t> _misses = 0;
+   std::atomic<uint64_t> _stores = 0;
+   std::atomic<uint64_t> _evictions = 0;
+};
@@ -1,11 +1,25 @@
 #pragma once
 
+#include <iosfwd>
 #include <vector>
 #include <string>
 
 class WordleDictionary
 {
 public:
+   // the number of possible answers (2315) -- `getWords` takes at most this many
+   static int numAnswers();
    static std::vector<std::string> getWords( int numberOfWords );
+
+   // every allowed guess, with the `numberOfAnswers` words returned by `getWords` first (so they keep the same index as guesses and as answers)
+   // the remaining words can still be guessed as "probes", even though they can't be the answer: the other answers, followed by
+   // the words from `readGuessList` (there are none built in -- the dictionary only has the answers)
+   static std::vector<std::string> getGuesses( int numberOfAnswers );
+   // the number of words `getGuesses` returns
+   static int numGuesses();
+
+   // adds the words in `in` (whitespace-separated, e.g. the game's list of allowed guesses) to the words `getGuesses` returns
+   // the answers and repeated words are skipped -- throws if a word isn't WORD_LEN letters
+   static void readGuessList( std::istream& in );
 };
 
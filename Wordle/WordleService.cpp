@@ -0,0 +1,155 @@
+#include "WordleService.h"
+#include "Solver.h"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+   // the word as a base-26 number, or UINT32_MAX if it isn't WORD_LEN lowercase letters
+   uint32_t wordCode( string_view word )
+   {
+      if ( word.size() != WORD_LEN )
+         return UINT32_MAX;
+      uint32_t ret = 0;
+      for ( char c : word )
+      {
+         if ( c < 'a' || c > 'z' )
+            return UINT32_MAX;
+         ret = ret * 26 + ( c - 'a' );
+      }
+      return ret;
+   }
+
+   // splits off the next space-separated token of `str` (empty if there are none left)
+   string_view nextToken( string_view& str )
+   {
+      size_t begin = str.find_first_not_of( " \t\r" );
+      if ( begin == string_view::npos )
+      {
+         str = {};
+         return {};
+      }
+      size_t end = min( str.find_first_of( " \t\r", begin ), str.size() );
+      string_view ret = str.substr( begin, end - begin );
+      str.remove_prefix( end );
+      return ret;
+   }
+}
+
+WordleService::WordleService( const SolutionFile& file ) : _file( file )
+{
+   setDictionary( file.words(), file.table() );
+   g_numGuesses = file.numGuesses(); // (so the off-tree search plays the same game the tree was solved for)
+   g_objective = file.objective();
+
+   for ( int i = 0; i < (int) file.words().size(); i++ )
+      _wordForCode.push_back( { wordCode( file.words()[i] ), i } );
+   sort( _wordForCode.begin(), _wordForCode.end() );
+
+   _history.reserve( MAX_NUM_GUESSES ); // (`answerQuery` rejects longer queries)
+   _candidateWords.reserve( file.numAnswers() );
+}
+
+int WordleService::wordIndex( string_view word ) const
+{
+   uint32_t code = wordCode( word );
+   auto it = lower_bound( _wordForCode.begin(), _wordForCode.end(), pair<uint32_t, int>( code, 0 ) );
+   if ( code == UINT32_MAX || it == _wordForCode.end() || it->first != code )
+      return -1;
+   return it->second;
+}
+
+int WordleService::nextGuess( span<const Feedback> history )
+{
+   const DecisionTree& tree = _file.tree();
+   if ( tree.empty() )
+      return nextGuessOffTree( history );
+
+   int node = 0;
+   for ( const Feedback& feedback : history )
+   {
+      if ( node == SOLVED )
+         return SOLVED;
+      if ( tree.node( node ).guess != feedback.guess )
+         return nextGuessOffTree( history );
+      node = tree.child( node, feedback.bucket );
+      if ( node == IMPOSSIBLE )
+         return IMPOSSIBLE;
+   }
+   return node == SOLVED ? SOLVED : tree.node( node ).guess;
+}
+
+int WordleService::nextGuessOffTree( span<const Feedback> history )
+{
+   for ( const Feedback& feedback : history )
+      if ( feedback.bucket == CORRECT_ANSWER_BUCKET )
+         return SOLVED;
+   int numGuessesLeft = g_numGuesses - (int) history.size();
+   if ( numGuessesLeft <= 0 )
+      return IMPOSSIBLE;
+
+   _candidateWords.clear();
+   for ( int answer = 0; answer < g_numAnswers; answer++ )
+   {
+      bool isConsistent = true;
+      for ( const Feedback& feedback : history )
+         isConsistent = isConsistent && g_BucketForGuessTable.bucket( feedback.guess, answer ) == feedback.bucket;
+      if ( isConsistent )
+         _candidateWords.push_back( answer );
+   }
+   if ( _candidateWords.empty() )
+      return IMPOSSIBLE;
+   if ( _candidateWords.size() == 1 )
+      return _candidateWords[0];
+
+   int bestGuess = _candidateWords[0];
+   calcScore( _candidateWords, bestGuess, numGuessesLeft );
+   // if the answer can't always be found in time, `calcScore` has no guess (-1, the same as SOLVED) -- a candidate might still be right
+   return bestGuess >= 0 ? bestGuess : _candidateWords[0];
+}
+
+void WordleService::answerQuery( string_view query, string& out )
+{
+   _history.clear();
+   for ( string_view guessStr = nextToken( query ); !guessStr.empty(); guessStr = nextToken( query ) )
+   {
+      int guess = wordIndex( guessStr );
+      int bucket = strToBucket( nextToken( query ) );
+      if ( guess == -1 || bucket == -1 || (int) _history.size() == g_numGuesses ) // (checked before appending, so `_history` never grows)
+      {
+         out += "invalid";
+         return;
+      }
+      _history.push_back( { guess, bucket } );
+   }
+
+   int guess = nextGuess( _history );
+   if ( guess == SOLVED )
+      out += "solved";
+   else if ( guess == IMPOSSIBLE )
+      out += "impossible";
+   else
+      out += _file.words()[guess];
+}
+
+void WordleService::serve( istream& in, ostream& out )
+{
+   string line;
+   string response;
+   while ( getline( in, line ) )
+   {
+      answerQuery( line, response );
+      response += '\n';
+      if ( in.rdbuf()->in_avail() <= 0 )
+      {
+         out.write( response.data(), response.size() );
+         out.flush();
+         response.clear();
+      }
+   }
+   out.write( response.data(), response.size() );
+   out.flush();
+}
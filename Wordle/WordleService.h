@@ -0,0 +1,54 @@
+#pragma once
+
+#include "SolutionFile.h"
+
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// answers "given these guesses and their feedback, what should I guess next?" from a solved SolutionFile
+// states on the tree are a walk of at most MAX_NUM_GUESSES nodes (no allocations); states off the tree (e.g. the player
+// didn't follow the tree's guesses) fall back to searching the remaining candidates with `calcScore`
+// uses the global solver state (see Solver.h), so there should be only one service per process
+class WordleService
+{
+public:
+   static constexpr int SOLVED = -1;     // the last guess was correct
+   static constexpr int IMPOSSIBLE = -2; // no answer is consistent with the feedback (or no guesses are left)
+
+   struct Feedback
+   {
+      int guess; // index into `words()`
+      int bucket;
+   };
+
+   // `file` must outlive the service -- the solver's guess limit and objective are set to the file's
+   explicit WordleService( const SolutionFile& file );
+
+   const std::vector<std::string>& words() const { return _file.words(); }
+   // index of `word` in `words()`, or -1 if it isn't in the dictionary
+   int wordIndex( std::string_view word ) const;
+
+   // the next guess (an index into `words()`), or SOLVED / IMPOSSIBLE
+   int nextGuess( std::span<const Feedback> history );
+
+   // `query` is a line of guess/feedback pairs in `bucketToStr` notation, e.g. "slate __#_# crane _##_#" (empty for the first guess)
+   // appends the next guess to `out`, or "solved" / "impossible" / "invalid" (also for more guesses than the guess limit)
+   void answerQuery( std::string_view query, std::string& out );
+
+   // answers one query per line until `in` ends
+   // output is only flushed once `in` has no more buffered input, so piped queries are answered in batches
+   void serve( std::istream& in, std::ostream& out );
+
+private:
+   int nextGuessOffTree( std::span<const Feedback> history );
+
+   const SolutionFile& _file;
+   std::vector<std::pair<uint32_t, int>> _wordForCode; // sorted by code (see `wordCode`)
+   std::vector<Feedback> _history;                     // reused by `answerQuery`
+   std::vector<int> _candidateWords;                   // reused by `nextGuessOffTree`
+};
@@ -1,339 +1,373 @@
+#include "Benchmark.h"
+#include "DecisionTreeWriter.h"
+#include "ParallelFor.h"
+#include "SearchStats.h"
+#include "SolutionFile.h"
+#include "Solver.h"
+#include "StrategyEvaluation.h"
 #include "Timer.h"
 #include "WordleDictionary.h"
+#include "WordleService.h"
 
+#include <fstream>
 #include <iostream>
-#include <functional>
-#include <unordered_map>
+#include <optional>
+#include <sstream>
 #include <algorithm>
-#include <bit>
 
 using namespace std;
 
-constexpr int MAX_NUM_GUESSES = 6;
-constexpr int WORD_LEN = 5;
-constexpr int CORRECT_ANSWER_BUCKET = 121;
-constexpr double INF = 1e20;
-string bucketToStr( int bucket )
+// solves every dictionary size from `firstSize` up
+// if `isIncremental`, each size reuses the previous one's work: the table only grows by the new word, the transposition cache is kept,
+// and the previous tree with the new word inserted gives an upper bound to start the search with
+void searchWithIncreasingDictionarySizes( int firstSize, bool isIncremental )
 {
-   string ret;
-   for ( int i = 0; i < WORD_LEN; i++, bucket /= 3 )
+   DecisionTree tree;
+   for ( int sz = firstSize; ; sz += 1 )
    {
-      int bucketType = bucket % 3;
-      ret += string("_#~")[bucketType];
-   }
-   reverse( ret.begin(), ret.end() );
-   return ret;
-}
-
-int calcBucketForGuess( const string& guess, const string& answer )
-{
-   int otherLetters[26] = { 0 };
-   int buckets[WORD_LEN] = { 0 };
-   for ( int i = 0; i < WORD_LEN; i++ )
-      if ( guess[i] == answer[i] )
-         buckets[i] = 1;
+      Timer t;
+      if ( isIncremental && !tree.empty() )
+         growDictionary( sz );
       else
-         otherLetters[answer[i]-'a']++;
-   for ( int i = 0; i < WORD_LEN; i++ )
-      if ( guess[i] != answer[i] )
-         if ( otherLetters[guess[i]-'a']-- > 0 )
-            buckets[i] = 2;
+         setDictionary( sz );
+      vector<int> words = rootWords();
 
-   int ret = 0;
-   for ( int i = 0; i < WORD_LEN; i++ )
-      ret = ret * 3 + buckets[i];
-   return ret;
+      // (a little slack is added so rounding can never turn the exact score into a cutoff)
+      double upperBoundScore = tree.empty() ? INF : scoreWithNewAnswer( tree, sz-1, sz-1 ) + 1e-9;
+      int bestGuess = words[0];
+      double score = calcScore( words, bestGuess, g_numGuesses, upperBoundScore );
+      if ( score >= upperBoundScore )
+         score = calcScore( words, bestGuess, g_numGuesses );
+      if ( isIncremental )
+         tree = calcDecisionTree();
+      cout << sz << "\t" << score << "\t" << t.elapsedTime() << "\t" << g_allWords[bestGuess] << endl;
+   }
 }
 
-vector<string> g_allWords;
-
-
-class BucketForGuessTable
+// solves the tree for the first `dictionarySize` words, and saves it (along with the dictionary and its BucketForGuessTable) to `path`
+void saveSolutionFile( int dictionarySize, const string& path )
 {
-public:
-   BucketForGuessTable()
-   {
-      int n = (int) g_allWords.size();
-      m.resize( n );
-
-      for ( int a = 0; a < n; a++ )
-         for ( int b = 0; b < n; b++ )
-            m[a].push_back( calcBucketForGuess( g_allWords[a], g_allWords[b] ) );
-   }
-   uint8_t bucket( int guess, int answer ) { return m[guess][answer]; }
+   setDictionary( dictionarySize );
 
-public:
-   vector<vector<uint8_t>> m;
-} g_BucketForGuessTable;
+   Timer t;
+   DecisionTree tree = calcDecisionTree();
+   SolutionFile::write( path, g_allWords, g_numAnswers, g_numGuesses, g_objective, g_BucketForGuessTable, tree );
+   cout << "saved " << path << ": " << g_numAnswers << " answers, " << g_allWords.size() << " guesses, " << tree.nodes().size() << " nodes, score = " << tree.score() << ", time = " << t.elapsedTime() << endl;
+}
 
-// returns -1 if no guess is "optimal" (i.e. putting candidateWords into a separate bucket)
-int optimalGuess( const vector<int>& candidateWords )
+void loadSolutionFile( const string& path )
 {
-   for ( int guess : candidateWords )
-   {
-      uint64_t bucketsUsed[4] = { 0 };
-      for ( int candidateWord : candidateWords ) if ( guess != candidateWord )
-      {
-         uint8_t bucket = g_BucketForGuessTable.bucket( guess, candidateWord );
-         if ( bucketsUsed[bucket/64] & (1LL<<(bucket&63)) )
-            goto skip;
-         bucketsUsed[bucket/64] |= (1LL<<(bucket&63));
-      }
-      return guess;
-   skip:;
-   }
-   return -1;
+   Timer t;
+   SolutionFile file( path );
+   cout << "loaded " << path << ": " << file.numAnswers() << " answers, " << file.words().size() << " guesses, " << file.tree().nodes().size() << " nodes, "
+        << ( file.objective() == Objective::WorstCase ? "worst case" : "expected" ) << " score = " << file.tree().score() << " within " << file.numGuesses() << " guesses"
+        << ", first guess = " << file.words()[file.tree().node( 0 ).guess] << ", time = " << t.elapsedTime() << endl;
 }
 
-vector<int> goodOrderForCandidateWords( vector<int> candidateWords )
+// answers next-guess queries from stdin until it ends (see `WordleService::answerQuery` for the format)
+// the guess limit and objective are the file's -- `hasGuessesOption`/`hasObjectiveOption` say if they were also given on the command line,
+// in which case they must agree with it
+void serveSolutionFile( const string& path, bool hasGuessesOption, bool hasObjectiveOption )
 {
-   if ( candidateWords.size() < 50 )
-      return candidateWords;
-
-   int letterFrequency[26] = { 0 }; // but only count letter once in each word
-   for ( int word : candidateWords )
-   {
-      int used = 0;
-      for ( int i = 0; i < WORD_LEN; i++ )
-      {
-         int letter = g_allWords[word][i] - 'a';
-         if ( used & (1<<letter) ) 
-            continue;
-         used |= 1<<letter;
-         letterFrequency[letter]++;
-      }
-   }
-
-   auto scoreForWord = [&letterFrequency]( int word ) { 
-      int score = 0;
-      for ( int i = 0; i < WORD_LEN; i++ )
-         score += letterFrequency[g_allWords[word][i]-'a'];
-      return score;
-   };
-   sort( candidateWords.begin(), candidateWords.end(), [&]( int a, int b ) { return scoreForWord( a ) > scoreForWord( b ); } );
-   return candidateWords;
+   SolutionFile file( path );
+   if ( ( hasGuessesOption && g_numGuesses != file.numGuesses() ) || ( hasObjectiveOption && g_objective != file.objective() ) )
+      throw "--guesses and --objective must match the solution file's (see `wordle load`)";
+   WordleService service( file );
+   ios::sync_with_stdio( false );
+   service.serve( cin, cout );
 }
 
-double calcScore( const vector<int>& candidateWords, int& bestGuess, int numGuessesLeft )
+void calcSearchTree( int dictionarySize, const string& statsJsonPath )
 {
-   if ( numGuessesLeft <= 0 )
-      return INF;
-   if ( candidateWords.size() == 1 )
-      return 1;
-   if ( numGuessesLeft <= 1 )
-      return INF;
-   if ( candidateWords.size() == 2 )
-      return 1.5;
-
-   double bestScore = INF;
+   setDictionary( dictionarySize );
+   g_transpositionCache.resetStats();
+   SearchStats::reset();
 
-   bool isTopLevel = candidateWords.size() == g_allWords.size();
-
-   // optimization -- quickly check for an optimal guess (i.e. a guess that puts each candidate into a separate bucket)
-   bestGuess = optimalGuess( candidateWords );
-   if ( bestGuess >= 0 )
+   Timer t;
+   DecisionTree tree;
    {
-      bestScore = 2 - 1./candidateWords.size();
+      optional<SearchStats::ProgressReporter> progress;
+      if ( SearchStats::ENABLED )
+         progress.emplace( cerr, 10.0 );
+      tree = calcDecisionTree();
    }
-   else
    {
-      if ( numGuessesLeft <= 2 ) // if optimal guess doesn't exist, we need at least 3 guesses
-         return INF; 
-
-      vector<int> candidateWordsInGoodGuessOrder = goodOrderForCandidateWords( candidateWords );
-
-      //if ( numGuessesLeft == MAX_NUM_GUESSES )
-      //   candidateWordsInGoodGuessOrder = { int( std::find( g_allWords.begin(), g_allWords.end(), "fjord" ) - g_allWords.begin() ) };
-
-      // score each guess, and keep track which is best
-      for ( int guess : candidateWordsInGoodGuessOrder )
-      {
-         uint64_t bucketsUsed[4] = { 0 };
-         for ( int candidateWord : candidateWords ) if ( guess != candidateWord )
-         {
-            uint8_t bucket = g_BucketForGuessTable.bucket( guess, candidateWord );
-            bucketsUsed[bucket/64] |= (1LL<<(bucket&63));
-         }
-         int numBucketsUsed = popcount( bucketsUsed[0] ) + popcount( bucketsUsed[1] ) + popcount( bucketsUsed[2] ) + popcount( bucketsUsed[3] );
-
-         //double lowerBoundScore = 3 - ( numBucketsUsed + ( guessIsACandidate ? 2 : 0 ) ) / (double) candidateWords.size();
-         double lowerBoundScore = 3 - ( numBucketsUsed + 2 ) / (double) candidateWords.size();
-
-         if ( lowerBoundScore >= bestScore )
-            continue;
-
-         double score = 1;
-
-         if ( candidateWords.size() > 64 )
-         {
-            unordered_map<int, vector<int>> wordsForBucket;
-            for ( int candidateWord : candidateWords ) if ( guess != candidateWord )
-            {
-               int bucket = g_BucketForGuessTable.bucket( guess, candidateWord );
-               wordsForBucket[bucket].push_back( candidateWord );
-            } 
-
-            for ( const auto& [bucket, remainingWords] : wordsForBucket )
-            {
-               double lowerBoundScoreForBucket = 2 - 1./remainingWords.size();
-               int localBestGuess = remainingWords[0];
-               double scoreForBucket = calcScore( remainingWords, localBestGuess, numGuessesLeft-1 );
-               score += scoreForBucket * remainingWords.size() / candidateWords.size();
-               lowerBoundScore += ( scoreForBucket - lowerBoundScoreForBucket ) * remainingWords.size() / candidateWords.size();
-               if ( lowerBoundScore >= bestScore )
-                  break;
-            }
-            if ( lowerBoundScore >= bestScore )
-               continue;
-         }
-         else // optimization -- use bit flags (uint64_t) instead of vector<int>
-         {
-            unordered_map<int, uint64_t> wordsForBucket;
-            for ( int candidateWordIndex = 0; candidateWordIndex < (int) candidateWords.size(); candidateWordIndex++ ) if ( guess != candidateWords[candidateWordIndex] )
-            {
-               int bucket = g_BucketForGuessTable.bucket( guess, candidateWords[candidateWordIndex] );
-               wordsForBucket[bucket] |= 1LL << candidateWordIndex;
-            }
-
-            for ( const auto& [bucket, remainingWordsBits] : wordsForBucket )
-            {
-               int remainingWordsSize = popcount( remainingWordsBits );
-               double lowerBoundScoreForBucket = 2 - 1./remainingWordsSize;
-
-               vector<int> remainingWords;
-               {
-                  remainingWords.reserve( remainingWordsSize );
-                  uint64_t r = remainingWordsBits;
-                  while ( r )
-                  {
-                     int idx = countr_zero( r );
-                     r &= ~(1LL << idx); // clear the bit
-                     remainingWords.push_back( candidateWords[idx] );
-                  }
-               }
-               int localBestGuess = remainingWords[0];
-               double scoreForBucket = calcScore( remainingWords, localBestGuess, numGuessesLeft-1 );
-               score += scoreForBucket * remainingWordsSize / candidateWords.size();
-               lowerBoundScore += ( scoreForBucket - lowerBoundScoreForBucket ) * remainingWordsSize / candidateWords.size();
-               if ( lowerBoundScore >= bestScore )
-                  break;
-            }
-            if ( lowerBoundScore >= bestScore )
-               continue;
-         }
-
-         //if ( isTopLevel )
-         //{
-         //   cout << g_allWords[guess] << " " << score << "    " << lowerBoundScore << endl;
-         //}
-
-         if ( score < bestScore )
-         {
-            bestScore = score;
-            bestGuess = guess;
-         }
-
-         if ( bestScore < 2.0000001 )
-            break; // nothing can be better, since we checked for optimal already
-      }
+      DecisionTreeWriter writer( cout, g_allWords );
+      writer.writeText( tree );
    }
+   double elapsedTime = t.elapsedTime();
+   cout << "score = " << tree.score() << endl;
+   cout << "time = " << elapsedTime << endl;
 
+   TranspositionCache::Stats cacheStats = g_transpositionCache.stats();
+   cout << "cache: hits = " << cacheStats.hits << ", lower bound hits = " << cacheStats.lowerBoundHits << ", misses = " << cacheStats.misses
+        << ", stores = " << cacheStats.stores << ", evictions = " << cacheStats.evictions << endl;
 
-   //if ( isTopLevel )
-   //{
-   //   cout << g_allWords[bestGuess] << bestGuess << endl;
-   //}
-
-   return bestScore;
-}
-
-void searchWithIncreasingDictionarySizes()
-{
-   for ( int sz = 670; ; sz += 1 )
+   if ( SearchStats::ENABLED )
    {
-      g_allWords = WordleDictionary::getWords( sz );
-
-      vector<int> words;
-      for ( int i = 0; i < (int) g_allWords.size(); i++ )
-         words.push_back( i );
-
-      g_BucketForGuessTable = BucketForGuessTable();
-
-      Timer t;
-      int bestGuess = words[0];
-      double score = calcScore( words, bestGuess, MAX_NUM_GUESSES );
-      cout << sz << "\t" << score << "\t" << t.elapsedTime() << "\t" << g_allWords[bestGuess] << endl;
+      SearchStats::writeReport( cout );
+      ofstream json( statsJsonPath );
+      SearchStats::writeJson( json, elapsedTime );
    }
 }
 
-double doSearchTree( const vector<int>& candidateWords, const string& prefix, int guessesLeft )
+// scores each of `openerWords` as the first guess (every word that can be guessed, if it's empty), and prints them best first
+// only the best `numExact` are guaranteed exact scores (0 = all) -- the rest may just be shown to be worse, with a lower bound
+void rankOpeners( int dictionarySize, const vector<string>& openerWords, int numExact )
 {
-   int guess = candidateWords[0]; 
-   double score = calcScore( candidateWords, guess, guessesLeft );  
-   if ( guess == -1 )
-      throw "invalid guess";
+   setDictionary( dictionarySize );
 
-   unordered_map<int, vector<int>> wordsForBucket;
-   for ( int candidateWord : candidateWords )
+   vector<int> openers;
+   for ( const string& word : openerWords )
    {
-      int bucket = g_BucketForGuessTable.bucket( guess, candidateWord );
-      wordsForBucket[bucket].push_back( candidateWord );
+      auto it = find( g_allWords.begin(), g_allWords.end(), word );
+      if ( it == g_allWords.end() )
+         throw "an opener isn't in the dictionary (see --all-words)";
+      openers.push_back( int( it - g_allWords.begin() ) );
    }
+   if ( openers.empty() )
+      for ( int i = 0; i < (int) g_allWords.size(); i++ )
+         openers.push_back( i );
 
-   vector<pair<int, vector<int>>> sortedWordsForBucket;
+   Timer t;
+   vector<StrategyEvaluation::OpenerScore> scores;
    {
-      for ( const auto& [bucket, remainingWords] : wordsForBucket )
-         sortedWordsForBucket.push_back( {bucket, remainingWords} );
-      sort( sortedWordsForBucket.begin(), sortedWordsForBucket.end(), []( const pair<int, vector<int>>& a, const pair<int, vector<int>>& b )
-      {
-         int scoreA = a.first == CORRECT_ANSWER_BUCKET ? 999999 : (int) a.second.size();
-         int scoreB = b.first == CORRECT_ANSWER_BUCKET ? 999999 : (int) b.second.size();
-         return scoreA > scoreB;
-      } );
+      optional<SearchStats::ProgressReporter> progress;
+      if ( SearchStats::ENABLED )
+         progress.emplace( cerr, 10.0 );
+      scores = StrategyEvaluation::rankOpeners( openers, numExact );
    }
-
-   for ( const auto& [bucket, remainingWords] : sortedWordsForBucket /*wordsForBucket*/ )
+   for ( int i = 0; i < (int) scores.size(); i++ )
    {
-      //vector<string> v;
-      //for ( int w : remainingWords )
-      //   v.push_back( g_allWords[w] );
-
-      //trace << g_allWords[guess] << " " << bucketToStr( bucket ) << " " << v << endl;
-
-      //trace << prefix << g_allWords[guess] << " " << bucketToStr( bucket ) << endl;
-
-      if ( bucket == CORRECT_ANSWER_BUCKET )
-         cout << prefix << g_allWords[guess] + " " + bucketToStr( bucket )/* << "  [" << score << "]"*/ << endl;
+      cout << i+1 << "\t" << g_allWords[scores[i].guess] << "\t";
+      if ( scores[i].score > g_numGuesses ) // (a score that's INF for some answer)
+         cout << "unsolvable" << endl;
       else
-         doSearchTree( remainingWords, prefix + g_allWords[guess] + " " + bucketToStr( bucket ) + "  ", guessesLeft-1 );
+         cout << ( scores[i].isExact ? "" : ">= " ) << scores[i].score << endl;
    }
+   cout << "time = " << t.elapsedTime() << endl;
+}
 
-   return score;
+// scores the tree at `path` (in the format `tree` prints) against every answer
+void scoreTreeFile( int dictionarySize, const string& path )
+{
+   setDictionary( dictionarySize );
+   ifstream in( path );
+   if ( !in )
+      throw "in `scoreTreeFile`: can't open the tree";
+
+   DecisionTree tree = StrategyEvaluation::readTree( in );
+   StrategyEvaluation::TreeScore treeScore = StrategyEvaluation::scoreTree( tree );
+   cout << "score = " << treeScore.score << endl;
+   for ( int numGuesses = 1; numGuesses <= g_numGuesses; numGuesses++ )
+      cout << numGuesses << " guesses: " << treeScore.numAnswersForNumGuesses[numGuesses] << endl;
+   cout << "unsolved: " << treeScore.unsolvedAnswers.size();
+   for ( int i = 0; i < min( 10, (int) treeScore.unsolvedAnswers.size() ); i++ )
+      cout << " " << g_allWords[treeScore.unsolvedAnswers[i]];
+   cout << endl;
 }
 
-void calcSearchTree( int dictionarySize )
+// runs the benchmarks, writes their report to `reportPath`, and returns the number of regressions against the report at `baselinePath` (if any)
+int runBenchmarks( const vector<int>& sizes, int repetitions, const string& reportPath, const string& baselinePath, double tolerance )
 {
-   g_allWords = WordleDictionary::getWords( dictionarySize );
-   g_BucketForGuessTable = BucketForGuessTable();
+   Benchmark benchmark( repetitions );
+   benchmark.run( sizes, cout );
+
+   ofstream report( reportPath );
+   benchmark.writeReport( report );
+   cout << "report written to " << reportPath << endl;
+
+   if ( baselinePath.empty() )
+      return 0;
+   ifstream baseline( baselinePath );
+   if ( !baseline )
+      throw "in `runBenchmarks`: can't open the baseline report";
+   int numRegressions = benchmark.compare( Benchmark::readReport( baseline ), tolerance, cout );
+   cout << numRegressions << " regressions (tolerance " << tolerance * 100 << "%)" << endl;
+   return numRegressions;
+}
 
-   vector<int> words;
-   for ( int i = 0; i < (int) g_allWords.size(); i++ )
-      words.push_back( i );
+const char* USAGE = R"(usage: wordle [mode] [options]
+
+modes:
+   tree        solves the dictionary and prints the decision tree (default)
+   sweep       solves every dictionary size from --first-size up (never stops)
+   save        solves the dictionary and saves it to --file
+   load        loads --file and prints a summary
+   serve       answers next-guess queries from stdin using --file
+   evaluate    ranks --openers by their score as the first guess, or scores the tree at --tree
+   benchmark   times the main pieces of the solver and writes a CSV report
+
+options:
+   --size N          number of possible answers (default 2315)
+   --guesses N       guess limit (default and maximum 6)
+   --all-words       also guess words that can't be the answer: the answers beyond --size, and the --guess-list words
+                     (the built-in dictionary only has the 2315 answers, so at --size 2315 this needs a --guess-list)
+   --guess-list PATH extra words to guess, one per line (e.g. the game's allowed guesses) -- implies --all-words
+   --objective X     expected (the average number of guesses, default) or worst-case (the most guesses)
+   --hard            hard mode: each guess must be consistent with the feedback so far (needs --all-words and words beyond --size)
+   --threads N       number of search threads (default: one per core)
+   --cache-mb N      memory for the transposition cache, in MB (default 512, 0 = no cache)
+   --file PATH       solution file for save/load/serve (default wordle<size>.bin)
+   --first-size N    first dictionary size of the sweep (default 670)
+   --cold            sweep without reusing the previous size's work
+   --stats-json PATH where tree writes the search stats (default search_stats.json; needs WORDLE_INSTRUMENTATION)
+   --openers A,B,... openers for evaluate to rank (default: every word that can be guessed)
+   --top N           only the best N openers are guaranteed an exact score, the rest may get a lower bound (default 0 = all)
+   --tree PATH       tree for evaluate to score, in the format tree prints (one line per answer)
+   --sizes A,B,...   benchmark dictionary sizes (default 500,1000,2315)
+   --repetitions N   benchmark repetitions (default 3)
+   --report PATH     benchmark report (default benchmark.csv)
+   --baseline PATH   earlier benchmark report to compare against (exits with 2 on a regression)
+   --tolerance X     slowdown allowed before a benchmark counts as a regression (default 0.1)
+)";
+
+int run( const vector<string>& args )
+{
+   string mode = "tree";
+   int dictionarySize = 2315;
+   int firstSize = 670;
+   bool isIncremental = true;
+   string path;
+   string statsJsonPath = "search_stats.json";
+   bool hasStatsJsonOption = false;
+   vector<string> openerWords;
+   int numExactOpeners = 0;
+   string treePath;
+   vector<int> benchmarkSizes = { 500, 1000, 2315 };
+   int repetitions = 3;
+   string reportPath = "benchmark.csv";
+   string baselinePath;
+   double tolerance = 0.1;
+   optional<int> cacheMegabytes;
+   string guessListPath;
+   bool hasGuessesOption = false;
+   bool hasObjectiveOption = false;
+
+   for ( size_t i = 0; i < args.size(); i++ )
+   {
+      const string& arg = args[i];
+      auto value = [&]() -> const string&
+      {
+         if ( i + 1 == args.size() )
+            throw "missing value for an option (see --help)";
+         return args[++i];
+      };
 
-   Timer t;
-   double score = doSearchTree( words, "", MAX_NUM_GUESSES );
-   cout << "score = " << score << endl;
-   cout << "time = " << t.elapsedTime() << endl;
+      if ( arg == "--help" || arg == "-h" )
+      {
+         cout << USAGE;
+         return 0;
+      }
+      else if ( arg == "--size" ) dictionarySize = stoi( value() );
+      else if ( arg == "--guesses" )
+      {
+         g_numGuesses = stoi( value() );
+         hasGuessesOption = true;
+      }
+      else if ( arg == "--all-words" ) g_guessFromAllWords = true;
+      else if ( arg == "--guess-list" )
+      {
+         guessListPath = value();
+         g_guessFromAllWords = true;
+      }
+      else if ( arg == "--hard" ) g_hardMode = true;
+      else if ( arg == "--objective" )
+      {
+         const string& objective = value();
+         if ( objective == "expected" ) g_objective = Objective::ExpectedGuesses;
+         else if ( objective == "worst-case" ) g_objective = Objective::WorstCase;
+         else throw "--objective must be expected or worst-case";
+         hasObjectiveOption = true;
+      }
+      else if ( arg == "--threads" ) g_numThreads = stoi( value() );
+      else if ( arg == "--cache-mb" ) cacheMegabytes = stoi( value() );
+      else if ( arg == "--file" ) path = value();
+      else if ( arg == "--first-size" ) firstSize = stoi( value() );
+      else if ( arg == "--cold" ) isIncremental = false;
+      else if ( arg == "--stats-json" )
+      {
+         statsJsonPath = value();
+         hasStatsJsonOption = true;
+      }
+      else if ( arg == "--top" ) numExactOpeners = stoi( value() );
+      else if ( arg == "--tree" ) treePath = value();
+      else if ( arg == "--openers" )
+      {
+         istringstream openers( value() );
+         for ( string opener; getline( openers, opener, ',' ); )
+            openerWords.push_back( opener );
+      }
+      else if ( arg == "--repetitions" ) repetitions = stoi( value() );
+      else if ( arg == "--report" ) reportPath = value();
+      else if ( arg == "--baseline" ) baselinePath = value();
+      else if ( arg == "--tolerance" ) tolerance = stod( value() );
+      else if ( arg == "--sizes" )
+      {
+         benchmarkSizes.clear();
+         istringstream sizes( value() );
+         for ( string size; getline( sizes, size, ',' ); )
+            benchmarkSizes.push_back( stoi( size ) );
+      }
+      else if ( !arg.starts_with( "-" ) && i == 0 ) mode = arg;
+      else throw "unknown option (see --help)";
+   }
+
+   if ( dictionarySize < 1 || dictionarySize > WordleDictionary::numAnswers() || firstSize < 1 || firstSize > WordleDictionary::numAnswers() )
+      throw "--size and --first-size must be between 1 and 2315";
+   if ( g_numGuesses < 1 || g_numGuesses > MAX_NUM_GUESSES )
+      throw "--guesses must be between 1 and 6";
+   if ( g_numThreads < 1 || repetitions < 1 )
+      throw "--threads and --repetitions must be positive";
+   if ( !guessListPath.empty() )
+   {
+      ifstream guessList( guessListPath );
+      if ( !guessList )
+         throw "can't open the --guess-list";
+      WordleDictionary::readGuessList( guessList );
+   }
+   // (hard mode only restricts the guesses that can't be the answer -- without any, it plays exactly like normal mode)
+   int smallestSize = mode == "sweep" ? firstSize : dictionarySize;
+   if ( g_hardMode && ( !g_guessFromAllWords || smallestSize == WordleDictionary::numGuesses() ) )
+      throw "--hard can't change anything without words to guess that can't be the answer (see --all-words and --guess-list)";
+   if ( hasStatsJsonOption && ( mode != "tree" || !SearchStats::ENABLED ) )
+      throw "--stats-json only applies to tree, in a build with WORDLE_INSTRUMENTATION";
+   if ( cacheMegabytes && *cacheMegabytes < 0 )
+      throw "--cache-mb can't be negative";
+   if ( cacheMegabytes )
+      g_transpositionCache.resize( *cacheMegabytes );
+   if ( path.empty() )
+      path = "wordle" + to_string( dictionarySize ) + ".bin";
+
+   if ( mode == "tree" ) calcSearchTree( dictionarySize, statsJsonPath );
+   else if ( mode == "sweep" ) searchWithIncreasingDictionarySizes( firstSize, isIncremental );
+   else if ( mode == "save" ) saveSolutionFile( dictionarySize, path );
+   else if ( mode == "load" ) loadSolutionFile( path );
+   else if ( mode == "serve" ) serveSolutionFile( path, hasGuessesOption, hasObjectiveOption );
+   else if ( mode == "evaluate" && !treePath.empty() ) scoreTreeFile( dictionarySize, treePath );
+   else if ( mode == "evaluate" ) rankOpeners( dictionarySize, openerWords, numExactOpeners );
+   else if ( mode == "benchmark" ) return runBenchmarks( benchmarkSizes, repetitions, reportPath, baselinePath, tolerance ) > 0 ? 2 : 0;
+   else throw "unknown mode (see --help)";
+   return 0;
 }
 
-int main()
+int main( int argc, char** argv )
 {
    if ( calcBucketForGuess( "abcde", "abcde" ) != CORRECT_ANSWER_BUCKET )
       throw "CORRECT_ANSWER_BUCKET constant incorrect";
 
-   //searchWithIncreasingDictionarySizes();
-   calcSearchTree( 2315 );
-      
-   { cout << "(press <enter> to exit)" << endl; cin.get(); }
-   return 0;
-}
\ No newline at end of file
+   try
+   {
+      return run( vector<string>( argv + 1, argv + argc ) );
+   }
+   catch ( const char* error )
+   {
+      cerr << "error: " << error << endl;
+      return 1;
+   }
+   catch ( const exception& e ) // e.g. `stoi` on a malformed number
+   {
+      cerr << "error: " << e.what() << endl;
+      return 1;
+   }
+}
@@ -3,6 +3,7 @@
 
 #ifdef _WIN32
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <Windows.h>
@@ -27,6 +28,18 @@ namespace std
          }
          return 0;
       }
+      // whole blocks (e.g. from DecisionTreeWriter) are taken at once, instead of one `overflow` per character
+      streamsize xsputn( const char* s, streamsize n )
+      {
+         buffer.append( s, (size_t) n );
+         if ( find( s, s + n, '\n' ) != s + n )
+         {
+            originalCoutStream << buffer;
+            ::OutputDebugStringA( buffer.c_str() );
+            buffer.clear();
+         }
+         return n;
+      }
    private:
       basic_ostream<char, std::char_traits<char>> originalCoutStream;
       string buffer;
@@ -0,0 +1,28 @@
+# regression check for `WordleService::nextGuessOffTree`: off the tree, a game whose candidates can't all be found in the
+# guesses left must still get one of its candidates as the next guess (not "solved")
+# run by ctest as `cmake -DWORDLE=<wordle executable> -DWORK_DIR=<dir> -P ServeOffTreeTest.cmake`
+
+set( SOLUTION_FILE ${WORK_DIR}/serve_off_tree_test.bin )
+set( QUERIES_FILE ${WORK_DIR}/serve_off_tree_test.txt )
+
+execute_process( COMMAND ${WORDLE} save --size 500 --file ${SOLUTION_FILE} RESULT_VARIABLE result OUTPUT_QUIET )
+if ( NOT result EQUAL 0 )
+   message( FATAL_ERROR "save failed" )
+endif()
+
+# the first guess (on the tree), then an off-tree game with several candidates and 2 guesses left
+file( WRITE ${QUERIES_FILE} "\nfluff _____ bobby _____ mimic _~___ whoop _____\n" )
+execute_process( COMMAND ${WORDLE} serve --file ${SOLUTION_FILE} INPUT_FILE ${QUERIES_FILE} RESULT_VARIABLE result OUTPUT_VARIABLE output )
+if ( NOT result EQUAL 0 )
+   message( FATAL_ERROR "serve failed" )
+endif()
+
+string( REPLACE "\n" ";" lines "${output}" )
+list( GET lines 0 firstGuess )
+list( GET lines 1 offTreeGuess )
+if ( NOT firstGuess STREQUAL "crate" )
+   message( FATAL_ERROR "first guess is `${firstGuess}`, expected `crate`" )
+endif()
+if ( NOT offTreeGuess MATCHES "^[a-z][a-z][a-z][a-z][a-z]$" )
+   message( FATAL_ERROR "off-tree guess is `${offTreeGuess}`, expected a word" )
+endif()